@@ -3,7 +3,7 @@
 #include <zephyr/logging/log.h>
 
 #include "ZephyrCppToolkit/Peripherals/IGpio.hpp"
-#include "ZephyrCppToolkit/EventThreadv2.hpp"
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
 
 #include "App.hpp"
 
@@ -12,22 +12,9 @@ LOG_MODULE_REGISTER(App, LOG_LEVEL_DBG);
 App::App(IPeripherals& peripherals)
     : 
     m_peripherals(peripherals),
-    m_eventThread("App", threadStack, THREAD_STACK_SIZE, EVENT_QUEUE_NUM_ITEMS, [this]() {
-        threadFunction();
-    }),
-    m_gpioTimer(AppEvents::GpioTimerExpired())
+    m_eventThread("App", threadStack, THREAD_STACK_SIZE, 7, EVENT_QUEUE_NUM_ITEMS),
+    m_gpioTimer("GpioTimer", m_eventThread, AppEvents::GpioTimerExpired())
 {
-    m_eventThread.timerManager().registerTimer(m_gpioTimer);
-}
-
-App::~App()
-{
-    m_eventThread.sendEvent(AppEvents::ExitCmd());
-}
-
-void App::threadFunction()
-{
-
     // Configure output GPIO
     zct::IGpio& outputGpio = m_peripherals.getOutputGpio();
     outputGpio.setDirection(zct::IGpio::Direction::Output);
@@ -41,24 +28,36 @@ void App::threadFunction()
         m_eventThread.sendEvent(event);
     });
 
-    while (true) {
-        auto event = m_eventThread.waitForEvent();
-        if (std::holds_alternative<AppEvents::InputGpioWentActive>(event)) {
-            LOG_INF("Input GPIO went active");
-
-            // Set output GPIO high.
-            outputGpio.set(true);
+    // External events and the GPIO timer event both end up here
+    m_eventThread.onExternalEvent([this](const AppEvents::Generic& event) {
+        handleEvent(event);
+    });
+    m_eventThread.start();
+}
 
-            // Start timer to make GPIO inactive after 1 minute
-            m_gpioTimer.start(1000*60, -1);
-        } else if (std::holds_alternative<AppEvents::GpioTimerExpired>(event)) {
-            LOG_INF("GPIO timer expired");
+App::~App()
+{
+    m_eventThread.sendEvent(AppEvents::ExitCmd());
+}
 
-            // Set output GPIO low.
-            outputGpio.set(false);
-        } else if (std::holds_alternative<AppEvents::ExitCmd>(event)) {
-            LOG_INF("Exit command received");
-            break;
-        } 
+void App::handleEvent(const AppEvents::Generic& event)
+{
+    zct::IGpio& outputGpio = m_peripherals.getOutputGpio();
+    if (std::holds_alternative<AppEvents::InputGpioWentActive>(event)) {
+        LOG_INF("Input GPIO went active");
+
+        // Set output GPIO high.
+        outputGpio.set(true);
+
+        // Start timer to make GPIO inactive after 1 minute
+        m_gpioTimer.start(1000*60, -1);
+    } else if (std::holds_alternative<AppEvents::GpioTimerExpired>(event)) {
+        LOG_INF("GPIO timer expired");
+
+        // Set output GPIO low.
+        outputGpio.set(false);
+    } else if (std::holds_alternative<AppEvents::ExitCmd>(event)) {
+        LOG_INF("Exit command received");
+        m_eventThread.exitEventLoop();
     }
-}
\ No newline at end of file
+}
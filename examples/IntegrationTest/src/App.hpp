@@ -1,10 +1,9 @@
-
 #pragma once
 
 #include <variant>
 
-#include "ZephyrCppToolkit/EventThreadv2.hpp"
-#include "ZephyrCppToolkit/Timer.hpp"
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/EventTimer.hpp"
 
 #include "IPeripherals.hpp"
 
@@ -21,14 +20,15 @@ public:
     App(IPeripherals& peripherals);
     ~App();
 
-    void threadFunction();
+    void handleEvent(const AppEvents::Generic& event);
 
 protected:
     IPeripherals& m_peripherals;
     static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
-    static constexpr size_t THREAD_STACK_SIZE = 512;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
     K_KERNEL_STACK_MEMBER(threadStack, THREAD_STACK_SIZE);
-    zct::EventThreadv2<AppEvents::Generic> m_eventThread;
+    zct::EventThread<AppEvents::Generic> m_eventThread;
 
-    zct::Timer<AppEvents::Generic> m_gpioTimer;
-};
\ No newline at end of file
+    // Delivers a GpioTimerExpired event to handleEvent() when it expires
+    zct::EventTimer<AppEvents::Generic> m_gpioTimer;
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+
+namespace zct {
+
+/**
+ * A linear (bump) allocator for memory which is allocated once at initialisation and never freed.
+ * 
+ * Toolkit objects which allocate in their constructor (EventThread, TimerManager, TimerGroup, CalendarScheduler,
+ * EventTraceRecorder and StateMachine) take an optional arena. If none is given they use the default arena set with
+ * setDefault(), and if there is no default either they fall back to the heap as before. This keeps all of the
+ * toolkit's memory in one known block, rather than scattered around the heap.
+ * 
+ * Once initialisation is finished, call freeze(). This logs how much of the arena was used, and turns any later
+ * allocation into an assert, catching code which allocates after boot.
+ * 
+ * Memory is only given back when the arena itself is destroyed. Objects allocated from it have their destructors
+ * called as normal, but the memory is not reused.
+ * 
+ * Example:
+ * \code
+ * static zct::StaticArena<4096> arena("toolkit");
+ * 
+ * int main() {
+ *     zct::Arena::setDefault(&arena);
+ *     // Create event threads, timer managers, etc.
+ *     arena.freeze();
+ * }
+ * \endcode
+ */
+class Arena {
+public:
+
+    /**
+     * \brief Create an arena which allocates from the given buffer.
+     * 
+     * \param buffer The memory to allocate from. Must outlive the arena.
+     * \param size_bytes The size of the buffer.
+     * \param name The name of the arena, used when logging.
+     */
+    Arena(uint8_t* buffer, size_t size_bytes, const char* name = "arena");
+
+    // Prevent copying, allocations point into the buffer
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * \brief Allocate a block of memory.
+     * 
+     * Asserts if the arena is frozen or there is not enough space left.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param size_bytes The number of bytes to allocate.
+     * \param alignment The alignment of the block. Must be a power of 2.
+     * \return The block, or nullptr if the arena is frozen or full (when asserts are disabled).
+     */
+    void* allocate(size_t size_bytes, size_t alignment);
+
+    /**
+     * \brief Stop any further allocations and log how much of the arena was used. Call this at the end of initialisation.
+     */
+    void freeze();
+
+    /**
+     * \brief Check if the arena has been frozen.
+     * 
+     * \return True if freeze() has been called.
+     */
+    bool isFrozen() const;
+
+    /**
+     * \brief Get the number of bytes allocated so far, including padding for alignment.
+     * 
+     * \return The bytes used.
+     */
+    size_t getUsed_bytes() const;
+
+    /**
+     * \brief Get the total size of the arena.
+     * 
+     * \return The size passed to the constructor.
+     */
+    size_t getSize_bytes() const;
+
+    /**
+     * \brief Get the number of allocations made from the arena.
+     * 
+     * \return The number of allocations.
+     */
+    uint32_t getNumAllocations() const;
+
+    /**
+     * \brief Log the arena usage at info level.
+     */
+    void logUsage() const;
+
+    /**
+     * \brief Set the arena used by toolkit objects which are not given one in their constructor.
+     * 
+     * \param arena The default arena, or nullptr to go back to allocating from the heap.
+     */
+    static void setDefault(Arena* arena);
+
+    /**
+     * \brief Get the default arena.
+     * 
+     * \return The default arena, or nullptr if none has been set.
+     */
+    static Arena* getDefault();
+
+    /**
+     * \brief Pick the arena a toolkit object should allocate from.
+     * 
+     * \param arena The arena passed to the object's constructor, if any.
+     * \return arena if it is not nullptr, otherwise the default arena (which may also be nullptr, meaning the heap).
+     */
+    static Arena* resolve(Arena* arena);
+
+    /**
+     * \brief Allocate and default construct an array of objects, from an arena or the heap.
+     * 
+     * \param arena The arena to allocate from (usually from resolve()), or nullptr for the heap.
+     * \param numItems The number of objects in the array.
+     * \return The array. Free it with deleteArray(), passing in the same arena.
+     */
+    template<typename T>
+    static T* newArray(Arena* arena, size_t numItems)
+    {
+        if (arena == nullptr) {
+            return new T[numItems];
+        }
+        T* items = static_cast<T*>(arena->allocate(sizeof(T) * numItems, alignof(T)));
+        if (items != nullptr) {
+            for (size_t i = 0; i < numItems; i++) {
+                new (&items[i]) T;
+            }
+        }
+        return items;
+    }
+
+    /**
+     * \brief Destroy an array created with newArray(). Heap memory is freed, arena memory is not.
+     * 
+     * \param arena The same arena that was passed to newArray().
+     * \param items The array.
+     * \param numItems The number of objects in the array.
+     */
+    template<typename T>
+    static void deleteArray(Arena* arena, T* items, size_t numItems)
+    {
+        if (arena == nullptr) {
+            delete[] items;
+            return;
+        }
+        if (items != nullptr) {
+            for (size_t i = 0; i < numItems; i++) {
+                items[i].~T();
+            }
+        }
+    }
+
+protected:
+    uint8_t* m_buffer;
+    size_t m_size_bytes;
+    const char* m_name;
+
+    size_t m_used_bytes = 0;
+    uint32_t m_numAllocations = 0;
+    bool m_isFrozen = false;
+
+    mutable SpinLock m_lock;
+
+    static Arena* s_default;
+};
+
+/**
+ * An arena which holds its own buffer. Make it a global or static so the memory is reserved at link time.
+ * 
+ * \tparam Size_bytes The size of the arena.
+ */
+template<size_t Size_bytes>
+class StaticArena : public Arena {
+public:
+
+    /**
+     * \brief Create an arena with a Size_bytes buffer.
+     * 
+     * \param name The name of the arena, used when logging.
+     */
+    StaticArena(const char* name = "arena") :
+        Arena(m_storage, Size_bytes, name)
+    {
+    }
+
+protected:
+    alignas(alignof(std::max_align_t)) uint8_t m_storage[Size_bytes];
+};
+
+} // namespace zct
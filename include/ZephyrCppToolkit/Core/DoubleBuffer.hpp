@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+namespace zct {
+
+/**
+ * A lock-free ping-pong buffer, for handing frames filled by a producer (typically a DMA transfer and its completion
+ * ISR) to a consumer thread which processes them in place.
+ * 
+ * The producer fills one buffer while the consumer processes the other. When a fill completes, the producer calls
+ * swap() to hand the buffer over and get the other one to fill next. If the consumer is still processing the other
+ * buffer, it can't be taken away, so the producer refills the same buffer and the frame is counted as an overrun.
+ * A frame the consumer hasn't started on yet is simply replaced by the newer one.
+ * 
+ * Only one producer and one consumer may use the buffer.
+ * 
+ * Each buffer is aligned to Alignment bytes, so they can be given to DMA controllers and kept in separate cache lines.
+ * Cache maintenance for DMA is still up to the caller.
+ * 
+ * Example:
+ * \code
+ * zct::DoubleBuffer<AdcFrame, 32> adcBuffer;
+ * 
+ * // At start up
+ * startDma(adcBuffer.getFillBuffer());
+ * 
+ * // DMA complete ISR
+ * startDma(adcBuffer.swap());
+ * 
+ * // Consumer thread
+ * const AdcFrame* frame = adcBuffer.acquire();
+ * if (frame != nullptr) {
+ *     process(*frame);
+ *     adcBuffer.release();
+ * }
+ * \endcode
+ * 
+ * \tparam T The type of each buffer.
+ * \tparam Alignment The alignment of each buffer in bytes.
+ */
+template<typename T, size_t Alignment = alignof(T)>
+class DoubleBuffer {
+public:
+
+    DoubleBuffer() = default;
+
+    // Prevent copying, the producer may hold pointers to this object's buffers
+    DoubleBuffer(const DoubleBuffer&) = delete;
+    DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+    /**
+     * \brief Get the buffer the producer is currently filling.
+     * 
+     * Producer only.
+     * 
+     * \return The buffer being filled.
+     */
+    T* getFillBuffer()
+    {
+        return &m_slots[atomic_get(&m_state) & FILL_INDEX_MASK].data;
+    }
+
+    /**
+     * \brief Hand the buffer just filled to the consumer and get the buffer to fill next.
+     * 
+     * Producer only. Never blocks, safe to call from an ISR.
+     * 
+     * \return The buffer to fill next. This is the same buffer as before if the consumer is still processing the
+     *     other one, in which case the frame just filled is dropped.
+     */
+    T* swap()
+    {
+        while (true) {
+            atomic_val_t oldState = atomic_get(&m_state);
+            if (oldState & IS_IN_USE_FLAG) {
+                atomic_inc(&m_numOverruns);
+                return &m_slots[oldState & FILL_INDEX_MASK].data;
+            }
+            atomic_val_t newState = ((oldState & FILL_INDEX_MASK) ^ 1) | IS_READY_FLAG;
+            if (atomic_cas(&m_state, oldState, newState)) {
+                return &m_slots[newState & FILL_INDEX_MASK].data;
+            }
+        }
+    }
+
+    /**
+     * \brief Get the latest filled buffer to process, if there is one the consumer hasn't had yet.
+     * 
+     * Consumer only. Never blocks. Call release() once finished with the buffer.
+     * 
+     * \return The buffer to process, or nullptr if no new frame has been filled.
+     */
+    const T* acquire()
+    {
+        while (true) {
+            atomic_val_t oldState = atomic_get(&m_state);
+            if ((oldState & IS_READY_FLAG) == 0) {
+                return nullptr;
+            }
+            atomic_val_t newState = (oldState & FILL_INDEX_MASK) | IS_IN_USE_FLAG;
+            if (atomic_cas(&m_state, oldState, newState)) {
+                return &m_slots[(oldState & FILL_INDEX_MASK) ^ 1].data;
+            }
+        }
+    }
+
+    /**
+     * \brief Give the buffer returned by acquire() back, so the producer can fill it again.
+     * 
+     * Consumer only.
+     */
+    void release()
+    {
+        atomic_and(&m_state, ~IS_IN_USE_FLAG);
+    }
+
+    /**
+     * \brief Get the number of frames dropped because the consumer was still processing the previous one.
+     * 
+     * \return The number of overruns.
+     */
+    uint32_t getNumOverruns() const
+    {
+        return static_cast<uint32_t>(atomic_get(&m_numOverruns));
+    }
+
+protected:
+
+    static constexpr atomic_val_t FILL_INDEX_MASK = 0x1;
+    static constexpr atomic_val_t IS_READY_FLAG = 0x2;
+    static constexpr atomic_val_t IS_IN_USE_FLAG = 0x4;
+
+    /** Wraps each buffer so that both of them get the requested alignment. */
+    struct alignas(Alignment) Slot {
+        T data;
+    };
+
+    Slot m_slots[2] = {};
+
+    /** The buffer being filled, plus IS_READY_FLAG if the other one holds an unprocessed frame and IS_IN_USE_FLAG if the consumer has it. */
+    atomic_t m_state = ATOMIC_INIT(0);
+
+    atomic_t m_numOverruns = ATOMIC_INIT(0);
+};
+
+} // namespace zct
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "ZephyrCppToolkit/Core/StaticVector.hpp"
+
+namespace zct {
+
+/**
+ * A map with a fixed capacity and no heap usage, stored as a sorted array of key/value pairs.
+ * 
+ * Lookups are a binary search, O(log N). Inserts and erases shift the entries after them, O(N), which is cheap for the
+ * small maps typically found in firmware and much more cache friendly than a tree. Iterating visits the entries in key
+ * order.
+ * 
+ * \tparam Key The type of key. Must be comparable with <.
+ * \tparam Value The type of value.
+ * \tparam N The maximum number of entries.
+ */
+template<typename Key, typename Value, size_t N>
+class FlatMap {
+public:
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    /**
+     * \brief Create an empty map.
+     */
+    constexpr FlatMap() = default;
+
+    /**
+     * \brief Add an entry, or replace the value if the key is already present.
+     * 
+     * \param key The key.
+     * \param value The value.
+     * \return True on success, false if the key is new and the map is full.
+     */
+    constexpr bool insert(const Key& key, const Value& value)
+    {
+        value_type* entry = lowerBound(key);
+        if (entry != m_entries.end() && !(key < entry->first)) {
+            entry->second = value;
+            return true;
+        }
+        return m_entries.insert(entry, value_type(key, value)) != m_entries.end();
+    }
+
+    /**
+     * \brief Look up a key.
+     * 
+     * \param key The key.
+     * \return The value, or nullptr if the key is not present.
+     */
+    constexpr Value* find(const Key& key)
+    {
+        value_type* entry = lowerBound(key);
+        if (entry != m_entries.end() && !(key < entry->first)) {
+            return &entry->second;
+        }
+        return nullptr;
+    }
+
+    constexpr const Value* find(const Key& key) const
+    {
+        return const_cast<FlatMap*>(this)->find(key);
+    }
+
+    /**
+     * \brief Check if a key is present.
+     * 
+     * \param key The key.
+     * \return True if the key is present.
+     */
+    constexpr bool contains(const Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * \brief Remove an entry.
+     * 
+     * \param key The key of the entry to remove.
+     * \return True if the entry was removed, false if the key was not present.
+     */
+    constexpr bool erase(const Key& key)
+    {
+        value_type* entry = lowerBound(key);
+        if (entry == m_entries.end() || key < entry->first) {
+            return false;
+        }
+        m_entries.erase(entry);
+        return true;
+    }
+
+    constexpr void clear() { m_entries.clear(); }
+
+    constexpr iterator begin() { return m_entries.begin(); }
+    constexpr iterator end() { return m_entries.end(); }
+    constexpr const_iterator begin() const { return m_entries.begin(); }
+    constexpr const_iterator end() const { return m_entries.end(); }
+
+    constexpr size_t size() const { return m_entries.size(); }
+    static constexpr size_t capacity() { return N; }
+    constexpr bool empty() const { return m_entries.empty(); }
+    constexpr bool full() const { return m_entries.full(); }
+
+protected:
+
+    /** Find the first entry whose key is not less than key. */
+    constexpr value_type* lowerBound(const Key& key)
+    {
+        value_type* first = m_entries.begin();
+        size_t count = m_entries.size();
+        while (count > 0) {
+            size_t step = count / 2;
+            value_type* middle = first + step;
+            if (middle->first < key) {
+                first = middle + 1;
+                count -= step + 1;
+            } else {
+                count = step;
+            }
+        }
+        return first;
+    }
+
+    StaticVector<value_type, N> m_entries;
+};
+
+} // namespace zct
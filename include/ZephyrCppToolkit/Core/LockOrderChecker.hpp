@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * \file LockOrderChecker.hpp
+ * 
+ * Debug-only detection of inconsistent lock ordering between zct::Mutex objects, in the spirit of Linux's lockdep.
+ * 
+ * Every time a thread blocks on a mutex while already holding others, an edge "held -> acquiring" is added to a global
+ * lock-order graph. If the new edge closes a cycle, two threads could each end up holding one mutex while waiting on
+ * the other, so a violation is reported, even if this run happened not to deadlock. Locks taken with K_NO_WAIT cannot
+ * deadlock, so they are tracked as held but don't add edges.
+ * 
+ * Checking is opt-in. Set the `ZCT_LOCK_ORDER_CHECKING` CMake option to `ON`. If it is not enabled, nothing in this
+ * file is compiled and MutexLockGuard has no extra cost.
+ * 
+ * The graph and the per-thread held-lock stacks are fixed size. Override these macros to change the limits:
+ * - `ZCT_LOCK_ORDER_MAX_MUTEXES`: The number of mutexes which can be tracked at once (default 64).
+ * - `ZCT_LOCK_ORDER_MAX_THREADS`: The number of threads which can hold mutexes at once (default 16).
+ * - `ZCT_LOCK_ORDER_MAX_DEPTH`: The number of mutexes a thread can hold at once (default 8).
+ * Mutexes or threads beyond these limits are not checked, and a warning is logged once.
+ */
+
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+#ifndef ZCT_LOCK_ORDER_MAX_MUTEXES
+#define ZCT_LOCK_ORDER_MAX_MUTEXES 64
+#endif
+
+#ifndef ZCT_LOCK_ORDER_MAX_THREADS
+#define ZCT_LOCK_ORDER_MAX_THREADS 16
+#endif
+
+#ifndef ZCT_LOCK_ORDER_MAX_DEPTH
+#define ZCT_LOCK_ORDER_MAX_DEPTH 8
+#endif
+
+namespace zct {
+
+// Forward declarations
+class Mutex;
+
+/**
+ * Records the order mutexes are locked in and reports lock-order inversions. Called by MutexLockGuard, there is no need
+ * to call this directly.
+ */
+class LockOrderChecker {
+public:
+
+    /**
+     * Called when an inversion is found.
+     * 
+     * \param held The mutex which is already held by the current thread.
+     * \param acquiring The mutex the current thread is about to wait on, which some other code path has locked before
+     *     locking held.
+     */
+    typedef void (*ViolationHandler)(const Mutex& held, const Mutex& acquiring);
+
+    /**
+     * Call before locking a mutex.
+     * 
+     * \param mutex The mutex about to be locked.
+     * \param isBlocking False if the lock will not wait (K_NO_WAIT), in which case no ordering is recorded.
+     */
+    static void onLocking(Mutex& mutex, bool isBlocking);
+
+    /**
+     * Call after a mutex has been successfully locked.
+     * 
+     * \param mutex The mutex which was locked.
+     */
+    static void onLocked(Mutex& mutex);
+
+    /**
+     * Call before unlocking a mutex.
+     * 
+     * \param mutex The mutex about to be unlocked.
+     */
+    static void onUnlocking(Mutex& mutex);
+
+    /**
+     * Call when a mutex is destroyed, to free its slot in the graph.
+     * 
+     * \param mutex The mutex being destroyed.
+     */
+    static void onDestroyed(Mutex& mutex);
+
+    /**
+     * Replace the handler called when an inversion is found. The default handler logs both mutexes and asserts.
+     * Intended for tests.
+     * 
+     * \param handler The new handler, or nullptr to restore the default.
+     */
+    static void setViolationHandler(ViolationHandler handler);
+
+    /**
+     * Forget all recorded lock orderings. Intended for tests.
+     */
+    static void reset();
+
+protected:
+
+    /**
+     * Get the graph ID of a mutex, allocating one if it doesn't have one yet. Must be called with the checker's
+     * spinlock held.
+     * 
+     * \param mutex The mutex.
+     * \return The ID, or -1 if the graph is full.
+     */
+    static int getId(Mutex& mutex);
+};
+
+} // namespace zct
+
+#endif
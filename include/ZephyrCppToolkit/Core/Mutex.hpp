@@ -1,8 +1,18 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
 #include <zephyr/kernel.h>
 #include <tl/expected.hpp>
 
+#include "ZephyrCppToolkit/Core/LockOrderChecker.hpp"
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+
 namespace zct {
 
 // Forward declarations
@@ -16,7 +26,7 @@ public:
 
     ~MutexLockGuard();
 
-    // Prevent copying and moving
+    // Prevent copying. Moving hands the lock over to the new guard.
     MutexLockGuard(const MutexLockGuard&) = delete;
     MutexLockGuard& operator=(const MutexLockGuard&) = delete;
     MutexLockGuard(MutexLockGuard&&);
@@ -52,6 +62,14 @@ protected:
  * The recommended way to lock a mutex is to use the lockGuard() function which returns a MutexLockGuard object. This will automatically unlock the mutex when the lock guard goes out of scope.
  * 
  * Just like with the Zephyr mutex, they are not designed for use in interrupts.
+ * 
+ * Every mutex is added to a registry, so all live mutexes can be enumerated with forEach() or logged with logAll().
+ * Give mutexes a name in the constructor so they can be identified in the logs.
+ * 
+ * Contention statistics can be enabled per mutex with setStatsEnabled(). These record how often the mutex is
+ * locked, how often a thread had to wait for it, how long threads waited, how long it was held for and which thread
+ * held it last. This helps find the mutexes causing long waits or priority inversion. Statistics are off by default
+ * since they add a few cycle counter reads to every lock and unlock.
  *
  * \sa MutexLockGuard
  * 
@@ -60,18 +78,35 @@ protected:
  */
 class Mutex {
 public:
+
+    /** Contention statistics returned by getStats(). */
+    struct Stats {
+        uint32_t numAcquisitions = 0;       ///< The number of times the mutex was locked (not counting recursive locks).
+        uint32_t numContended = 0;          ///< The number of acquisitions which had to wait for another thread.
+        uint64_t totalWaitTime_us = 0;      ///< The total time spent waiting for the mutex.
+        uint32_t maxWaitTime_us = 0;        ///< The longest time spent waiting for the mutex.
+        uint32_t maxHoldTime_us = 0;        ///< The longest time the mutex was held for.
+        const char* lastOwnerName = "";     ///< The name of the thread which last locked the mutex, valid for the life of the mutex. Requires CONFIG_THREAD_NAME=y.
+    };
+
     /**
-     * \brief Construct a new mutex.
+     * \brief Construct a new mutex and add it to the registry.
      * 
      * The mutex starts of in an unlocked state. Use a MutexLockGuard to lock the mutex.
+     * 
+     * \param name The name of the mutex, used when logging. Must outlive the mutex. If nullptr, the address is logged instead.
      */
-    Mutex();
+    Mutex(const char* name = nullptr);
 
     /**
-     * \brief Destroy the mutex.
+     * \brief Destroy the mutex and remove it from the registry.
      */
     ~Mutex();
 
+    // Prevent copying, the registry holds a pointer to this object
+    Mutex(const Mutex&) = delete;
+    Mutex& operator=(const Mutex&) = delete;
+
     /**
      * \brief Get a lock guard for this mutex.
      * 
@@ -91,12 +126,214 @@ public:
      * \return A pointer to the Zephyr mutex object.
      */
     struct k_mutex* getZephyrMutex();
+
+    /**
+     * \brief Get the name of the mutex.
+     * 
+     * \return The name passed to the constructor, or nullptr if none was given.
+     */
+    const char* getName() const;
+
+    /**
+     * \brief Enable or disable contention statistics for this mutex.
+     * 
+     * Only locks and unlocks made through lockGuard() are recorded.
+     * 
+     * \param isEnabled True to record statistics.
+     */
+    void setStatsEnabled(bool isEnabled);
+
+    /**
+     * \brief Check if contention statistics are enabled for this mutex.
+     * 
+     * \return True if statistics are enabled.
+     */
+    bool getStatsEnabled() const;
+
+    /**
+     * \brief Get the contention statistics for this mutex.
+     * 
+     * THREAD SAFE.
+     * 
+     * \return A copy of the statistics.
+     */
+    Stats getStats() const;
+
+    /**
+     * \brief Reset the contention statistics back to 0.
+     * 
+     * THREAD SAFE.
+     */
+    void resetStats();
+
+    /**
+     * \brief Call a function for every mutex in the registry.
+     * 
+     * The registry is locked while iterating, so the function must not create or destroy mutexes.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param func The function to call.
+     */
+    static void forEach(const std::function<void(Mutex&)>& func);
+
+    /**
+     * \brief Log the statistics of every mutex in the registry which has statistics enabled, at info level.
+     * 
+     * Designed to be called periodically.
+     * 
+     * THREAD SAFE.
+     */
+    static void logAll();
+
+    // Allow MutexLockGuard to record statistics
+    friend class MutexLockGuard;
+
 protected:
 
+    /**
+     * Lock the mutex and record the wait time. Used instead of k_mutex_lock() when statistics are enabled.
+     * 
+     * \param timeout The timeout for the lock.
+     * \return The return code from k_mutex_lock().
+     */
+    int lockWithStats(k_timeout_t timeout);
+
+    /**
+     * Record the hold time. Called just before the mutex is unlocked when statistics are enabled.
+     */
+    void recordUnlock();
+
+    const char* m_name;
+
+    bool m_isStatsEnabled = false;
+
+    /** Protects the statistics below, so they can be read without locking the mutex itself. */
+    mutable SpinLock m_statsLock;
+    Stats m_stats;
+    uint64_t m_totalWaitTime_cycles = 0;
+    uint32_t m_maxWaitTime_cycles = 0;
+    uint32_t m_maxHoldTime_cycles = 0;
+
+    /** When the current owner locked the mutex, if statistics were enabled at the time. */
+    uint32_t m_lockTime_cycles = 0;
+    bool m_isLockTimeValid = false;
+
+    /** The thread which last locked the mutex, so the name is only copied when the owner changes. */
+    k_tid_t m_lastOwner = nullptr;
+#if defined(CONFIG_THREAD_NAME)
+    char m_lastOwnerName[CONFIG_THREAD_MAX_NAME_LEN] = {};
+#endif
+
+    /** The next mutex in the registry. */
+    Mutex* m_next = nullptr;
+
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+    /** This mutex's node in the lock-order graph, allocated the first time it is locked. */
+    int16_t m_lockOrderId = -1;
+
+    friend class LockOrderChecker;
+#endif
+
+    /** The first mutex in the registry. */
+    static Mutex* s_first;
+
     /**
      * The underlying Zephyr mutex object. Get access to this by calling getZephyrMutex().
      */
     struct k_mutex m_zephyrMutex;
 };
 
-} // namespace zct
\ No newline at end of file
+/**
+ * A RAII class that holds several mutexes locked at once, returned by lockAll(). All the mutexes are unlocked when the
+ * guard is destroyed, in the reverse order to which they were passed to lockAll(). This is not necessarily the reverse of
+ * the order they were locked in, since lockAll() may start locking from any of them. The unlock order cannot cause a
+ * deadlock.
+ * 
+ * \tparam NumMutexes The number of mutexes held.
+ */
+template<size_t NumMutexes>
+class MultiMutexLockGuard {
+public:
+
+    // Prevent copying. Moving hands the locks over to the new guard.
+    MultiMutexLockGuard(const MultiMutexLockGuard&) = delete;
+    MultiMutexLockGuard& operator=(const MultiMutexLockGuard&) = delete;
+    MultiMutexLockGuard(MultiMutexLockGuard&&) = default;
+    MultiMutexLockGuard& operator=(MultiMutexLockGuard&&) = delete;
+
+    template<typename... MutexTypes>
+    friend tl::expected<MultiMutexLockGuard<sizeof...(MutexTypes)>, int> lockAll(k_timeout_t timeout, MutexTypes&... mutexes);
+
+protected:
+    MultiMutexLockGuard() = default;
+
+    /** One guard per mutex, in the order passed to lockAll(). Empty while not locked. */
+    std::array<std::optional<MutexLockGuard>, NumMutexes> m_lockGuards;
+};
+
+/**
+ * \brief Lock several mutexes at once without risking a deadlock, no matter which order other threads lock them in.
+ * 
+ * Blocks on one mutex and then tries to lock the rest without waiting. If one of those is busy, everything is unlocked
+ * again and the next attempt blocks on the busy mutex instead. This means the thread sleeps rather than spins while
+ * another thread holds one of the mutexes, and never holds one mutex while waiting for another.
+ * 
+ * Example:
+ * \code
+ * auto lockGuard = zct::lockAll(K_MSEC(100), mutexA, mutexB);
+ * if (!lockGuard) {
+ *     LOG_ERR("Failed to lock mutexes: %d", lockGuard.error());
+ *     return;
+ * }
+ * // Both mutexes are locked until lockGuard goes out of scope
+ * \endcode
+ * 
+ * \param timeout The timeout for locking all the mutexes. Pass K_FOREVER to wait indefinitely, or K_NO_WAIT to not wait at all.
+ * \param mutexes The mutexes to lock.
+ * \return A guard holding all the mutexes, or the error code from k_mutex_lock() (-EBUSY or -EAGAIN) if the timeout expired.
+ *     No mutexes are left locked on error.
+ */
+template<typename... MutexTypes>
+tl::expected<MultiMutexLockGuard<sizeof...(MutexTypes)>, int> lockAll(k_timeout_t timeout, MutexTypes&... mutexes)
+{
+    static_assert((std::is_same_v<MutexTypes, Mutex> && ...), "lockAll() only accepts zct::Mutex objects.");
+    constexpr size_t numMutexes = sizeof...(MutexTypes);
+    static_assert(numMutexes > 0, "lockAll() needs at least one mutex.");
+
+    std::array<Mutex*, numMutexes> mutexPtrs = { &mutexes... };
+    MultiMutexLockGuard<numMutexes> multiLockGuard;
+    auto& lockGuards = multiLockGuard.m_lockGuards;
+
+    // Retrying must not extend the total timeout
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+    size_t firstIndex = 0;
+    while (true) {
+        lockGuards[firstIndex].emplace(mutexPtrs[firstIndex]->lockGuard(sys_timepoint_timeout(deadline)));
+        if (!lockGuards[firstIndex]->didGetLock()) {
+            // Match the codes k_mutex_lock() returns
+            return tl::unexpected(K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY : -EAGAIN);
+        }
+
+        size_t busyIndex = numMutexes;
+        for (size_t i = 1; i < numMutexes; i++) {
+            size_t index = (firstIndex + i) % numMutexes;
+            lockGuards[index].emplace(mutexPtrs[index]->lockGuard(K_NO_WAIT));
+            if (!lockGuards[index]->didGetLock()) {
+                busyIndex = index;
+                break;
+            }
+        }
+        if (busyIndex == numMutexes) {
+            return multiLockGuard;
+        }
+
+        // Back off, releasing everything, and wait on the busy mutex next time round
+        for (auto& lockGuard : lockGuards) {
+            lockGuard.reset();
+        }
+        firstIndex = busyIndex;
+    }
+}
+
+} // namespace zct
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <tl/expected.hpp>
+
+namespace zct {
+
+/**
+ * A typed, fixed-size memory pool built on a Zephyr memory slab.
+ * 
+ * Allocation and freeing are O(1) and can't fragment, so the pool is suitable for objects created and destroyed at
+ * runtime in hot paths (packets, requests, etc.), unlike the heap. The storage for all N objects is part of the pool
+ * object itself, so make the pool a global or static to keep it off the stack.
+ * 
+ * allocate() constructs the object and returns a Pool::Ptr, a std::unique_ptr which destroys the object and gives its
+ * block back to the pool when it goes out of scope.
+ * 
+ * Example:
+ * \code
+ * static zct::Pool<Packet, 8> packetPool;
+ * 
+ * auto packet = packetPool.allocate(K_MSEC(10), packetId);
+ * if (!packet) {
+ *     LOG_ERR("No free packets: %d", packet.error());
+ *     return;
+ * }
+ * (*packet)->send();
+ * \endcode
+ * 
+ * THREAD SAFE. allocate() can be called from an ISR with K_NO_WAIT.
+ * 
+ * \tparam T The type of object in the pool.
+ * \tparam N The number of objects the pool can hold.
+ */
+template<typename T, size_t N>
+class Pool {
+public:
+
+    /** Destroys the object and returns its block to the pool. Used by Ptr. */
+    class Deleter {
+    public:
+        Deleter() = default;
+
+        explicit Deleter(Pool* pool) :
+            m_pool(pool)
+        {
+        }
+
+        void operator()(T* object) const
+        {
+            object->~T();
+            m_pool->free(object);
+        }
+
+    protected:
+        Pool* m_pool = nullptr;
+    };
+
+    /** An owning handle to an object in the pool. */
+    using Ptr = std::unique_ptr<T, Deleter>;
+
+    /**
+     * \brief Create a new pool. All N blocks start off free.
+     */
+    Pool()
+    {
+        int rc = k_mem_slab_init(&m_slab, m_buffer, BLOCK_SIZE, N);
+        __ASSERT(rc == 0, "Failed to initialise memory slab: %d.", rc);
+        (void)rc;
+    }
+
+    /**
+     * \brief Destroy the pool. All objects must have been freed by now.
+     */
+    ~Pool()
+    {
+        __ASSERT(getNumUsed() == 0, "Pool destroyed while %u objects are still allocated.", (unsigned)getNumUsed());
+    }
+
+    // Prevent copying and moving, allocated objects point back to the pool
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * \brief Allocate a block from the pool and construct an object in it.
+     * 
+     * \param timeout How long to wait for a block to become free. Pass K_NO_WAIT to not wait at all (required from an ISR).
+     * \param args Arguments forwarded to T's constructor.
+     * \return An owning handle to the new object, or the error code from k_mem_slab_alloc() (-ENOMEM if no block was
+     *     free and K_NO_WAIT was given, -EAGAIN if the timeout expired).
+     */
+    template<typename... Args>
+    tl::expected<Ptr, int> allocate(k_timeout_t timeout, Args&&... args)
+    {
+        void* block;
+        int rc = k_mem_slab_alloc(&m_slab, &block, timeout);
+        if (rc != 0) {
+            return tl::unexpected(rc);
+        }
+        updateMaxUsed();
+        T* object = new (block) T(std::forward<Args>(args)...);
+        return Ptr(object, Deleter(this));
+    }
+
+    /**
+     * \brief Get the number of objects currently allocated.
+     * 
+     * \return The number of used blocks.
+     */
+    uint32_t getNumUsed()
+    {
+        return k_mem_slab_num_used_get(&m_slab);
+    }
+
+    /**
+     * \brief Get the number of objects which can still be allocated.
+     * 
+     * \return The number of free blocks.
+     */
+    uint32_t getNumFree()
+    {
+        return k_mem_slab_num_free_get(&m_slab);
+    }
+
+    /**
+     * \brief Get the most objects that have been allocated at once.
+     * 
+     * \return The high-water mark of used blocks.
+     */
+    uint32_t getMaxUsed() const
+    {
+        return static_cast<uint32_t>(atomic_get(&m_maxUsed));
+    }
+
+    /**
+     * \brief Get the number of objects the pool can hold.
+     * 
+     * \return N.
+     */
+    static constexpr size_t getCapacity()
+    {
+        return N;
+    }
+
+protected:
+
+    /** Memory slabs need blocks which are at least a pointer in size and aligned to a pointer. */
+    static constexpr size_t BLOCK_ALIGNMENT = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+    static constexpr size_t BLOCK_SIZE = ((sizeof(T) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT) * BLOCK_ALIGNMENT;
+
+    /**
+     * Give a block back to the slab. The object must already have been destroyed.
+     */
+    void free(T* object)
+    {
+        k_mem_slab_free(&m_slab, object);
+    }
+
+    /**
+     * Raise the high-water mark to the current usage, if it is higher. Lock-free so that it can run in an ISR.
+     */
+    void updateMaxUsed()
+    {
+        atomic_val_t numUsed = static_cast<atomic_val_t>(k_mem_slab_num_used_get(&m_slab));
+        atomic_val_t maxUsed = atomic_get(&m_maxUsed);
+        while (numUsed > maxUsed && !atomic_cas(&m_maxUsed, maxUsed, numUsed)) {
+            maxUsed = atomic_get(&m_maxUsed);
+        }
+    }
+
+    alignas(BLOCK_ALIGNMENT) char m_buffer[BLOCK_SIZE * N];
+
+    struct k_mem_slab m_slab;
+
+    atomic_t m_maxUsed = ATOMIC_INIT(0);
+};
+
+} // namespace zct
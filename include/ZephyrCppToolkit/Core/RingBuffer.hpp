@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+
+namespace zct {
+
+/**
+ * A fixed-capacity FIFO queue with no heap usage, for passing items between threads and ISRs.
+ * 
+ * With one producer and one consumer (the default), push() and pop() are lock-free and never block, so each side can
+ * be a thread or an ISR. Set IsMultiProducer to true to allow any number of producers, in which case push() serializes
+ * them with a SpinLock (still safe from ISRs). There must only ever be one consumer.
+ * 
+ * \tparam T The type of item. Must be default constructible and assignable.
+ * \tparam N The maximum number of items. Must be a power of 2.
+ * \tparam IsMultiProducer True if more than one thread or ISR can call push().
+ */
+template<typename T, size_t N, bool IsMultiProducer = false>
+class RingBuffer {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of 2.");
+    static_assert(N <= (1u << 31), "RingBuffer capacity must fit in the 32-bit counters.");
+public:
+
+    /**
+     * \brief Create an empty ring buffer.
+     */
+    constexpr RingBuffer() = default;
+
+    // Prevent copying, producers and consumers may be using it concurrently
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /**
+     * \brief Add an item to the back of the queue.
+     * 
+     * Producer only. Never blocks.
+     * 
+     * \param item The item to add.
+     * \return True on success, false if the queue is full.
+     */
+    bool push(const T& item)
+    {
+        if constexpr (IsMultiProducer) {
+            auto guard = m_producerLock.lockGuard();
+            return pushUnlocked(item);
+        } else {
+            return pushUnlocked(item);
+        }
+    }
+
+    /**
+     * \brief Remove the item at the front of the queue.
+     * 
+     * Consumer only. Never blocks.
+     * 
+     * \param item Populated with the item on success.
+     * \return True on success, false if the queue is empty.
+     */
+    bool pop(T& item)
+    {
+        uint32_t tail = getCount(m_tail);
+        if (getCount(m_head) == tail) {
+            return false;
+        }
+        item = std::move(m_items[tail & (N - 1)]);
+        // Hand the slot back to the producer only once the item has been read
+        setCount(m_tail, tail + 1);
+        return true;
+    }
+
+    /**
+     * \brief Get the number of items in the queue. May already be out of date if the other side is active.
+     * 
+     * \return The number of items.
+     */
+    size_t size() const
+    {
+        return getCount(m_head) - getCount(m_tail);
+    }
+
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == N; }
+    static constexpr size_t capacity() { return N; }
+
+protected:
+
+    bool pushUnlocked(const T& item)
+    {
+        uint32_t head = getCount(m_head);
+        if (head - getCount(m_tail) >= N) {
+            return false;
+        }
+        m_items[head & (N - 1)] = item;
+        // Publish the item only once it has been written
+        setCount(m_head, head + 1);
+        return true;
+    }
+
+    /**
+     * The counters are only ever handled as uint32_t, so they wrap around safely rather than overflowing a signed
+     * atomic_val_t. Since N is a power of 2, the indexes and the difference between the counters stay correct across
+     * the wrap.
+     */
+    static uint32_t getCount(const atomic_t& count)
+    {
+        return static_cast<uint32_t>(atomic_get(&count));
+    }
+
+    static void setCount(atomic_t& count, uint32_t value)
+    {
+        atomic_set(&count, static_cast<atomic_val_t>(value));
+    }
+
+    T m_items[N] = {};
+
+    /** Free-running counts of items pushed and popped, see getCount(). The indexes are these modulo N. */
+    atomic_t m_head = ATOMIC_INIT(0);
+    atomic_t m_tail = ATOMIC_INIT(0);
+
+    /** Serializes producers if IsMultiProducer is true, otherwise unused. */
+    SpinLock m_producerLock;
+};
+
+} // namespace zct
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+namespace zct {
+
+/**
+ * A sequence lock, for sharing a small snapshot (e.g. a sensor sample) written by an ISR or one thread with any number
+ * of reader threads, without locking.
+ * 
+ * The writer never waits: write() bumps a sequence counter to an odd value, copies the data in and bumps the counter
+ * back to even. Readers copy the data out optimistically and retry if the counter was odd or changed while copying, so
+ * a reader never returns a torn value which is half old and half new.
+ * 
+ * Rules:
+ * - There must only be one writer at a time. If more than one thread or ISR can write, serialize them yourself (e.g.
+ *   with a SpinLock).
+ * - read() spins while a write is in progress. If the writer is a thread, it must not be preempted by a spinning
+ *   reader on the same CPU, so make it higher priority than the readers (an ISR writer is always fine). Use tryRead()
+ *   from readers which could preempt the writer.
+ * - Keep T small. Readers retry the whole copy whenever they overlap with a write.
+ * 
+ * Example:
+ * \code
+ * struct Sample { int32_t x; int32_t y; int32_t z; };
+ * zct::SeqLock<Sample> latestSample;
+ * 
+ * void sensorIsr() {
+ *     latestSample.write(readSensor());
+ * }
+ * 
+ * void consumer() {
+ *     Sample sample = latestSample.read();
+ * }
+ * \endcode
+ * 
+ * \tparam T The type of the data. Must be trivially copyable, since it is copied while the writer may be modifying it.
+ */
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock data must be trivially copyable.");
+public:
+
+    /**
+     * \brief Create a new seqlock holding a value-initialised T.
+     */
+    SeqLock() = default;
+
+    /**
+     * \brief Create a new seqlock holding an initial value.
+     * 
+     * \param initialValue The value returned by read() until write() is first called.
+     */
+    explicit SeqLock(const T& initialValue) :
+        m_data(initialValue)
+    {
+    }
+
+    // Prevent copying, readers may be spinning on this object
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * \brief Write a new value. Never blocks, and is safe to call from an ISR.
+     * 
+     * Only one writer may call this at a time.
+     * 
+     * \param value The new value.
+     */
+    void write(const T& value)
+    {
+        // atomic_inc() is a full barrier, so the data writes can't move before the odd count or after the even one
+        atomic_inc(&m_sequence);
+        memcpy(&m_data, &value, sizeof(T));
+        atomic_inc(&m_sequence);
+    }
+
+    /**
+     * \brief Read the latest value, retrying until a copy is made which did not overlap with a write.
+     * 
+     * THREAD SAFE. Safe to call from an ISR as long as the writer is not running on the same CPU at a lower priority.
+     * 
+     * \return The latest value.
+     */
+    T read() const
+    {
+        T value;
+        while (!tryRead(value)) {
+            // The writer is part way through, try again
+        }
+        return value;
+    }
+
+    /**
+     * \brief Try to read the latest value once.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param value Populated with the latest value on success. Left in an unspecified state on failure.
+     * \return True on success, false if a write was in progress or happened during the copy.
+     */
+    bool tryRead(T& value) const
+    {
+        atomic_val_t startSequence = atomic_get(&m_sequence);
+        if (startSequence & 1) {
+            return false;
+        }
+        memcpy(&value, &m_data, sizeof(T));
+        // Make sure the copy completes before the sequence is checked again
+        barrier_dmem_fence_full();
+        return atomic_get(&m_sequence) == startSequence;
+    }
+
+    /**
+     * \brief Get the number of writes made so far. Useful for readers to check if there is a new value.
+     * 
+     * THREAD SAFE.
+     * 
+     * \return The number of completed writes.
+     */
+    uint32_t getNumWrites() const
+    {
+        return static_cast<uint32_t>(atomic_get(&m_sequence)) / 2;
+    }
+
+protected:
+
+    /** Odd while a write is in progress. */
+    atomic_t m_sequence = ATOMIC_INIT(0);
+
+    T m_data = {};
+};
+
+} // namespace zct
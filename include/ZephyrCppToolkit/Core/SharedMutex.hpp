@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+namespace zct {
+
+// Forward declarations
+class SharedMutex;
+
+/**
+ * A RAII class that locks a SharedMutex for shared (read) access when constructed and unlocks it when destroyed.
+ */
+class SharedMutexReadGuard {
+public:
+
+    ~SharedMutexReadGuard();
+
+    // Prevent copying
+    SharedMutexReadGuard(const SharedMutexReadGuard&) = delete;
+    SharedMutexReadGuard& operator=(const SharedMutexReadGuard&) = delete;
+    SharedMutexReadGuard(SharedMutexReadGuard&& other);
+    SharedMutexReadGuard& operator=(SharedMutexReadGuard&&) = delete;
+
+    /**
+     * \brief Check if the shared mutex was successfully locked with this guard.
+     * 
+     * \return True if the shared mutex was successfully locked with this guard, false otherwise.
+     */
+    bool didGetLock() const;
+
+    // Allow SharedMutex to construct SharedMutexReadGuard objects
+    friend class SharedMutex;
+
+protected:
+    /**
+     * \brief Constructor is hidden since we only want to allow the SharedMutex class to construct guard objects.
+     */
+    SharedMutexReadGuard(SharedMutex& sharedMutex, k_timeout_t timeout);
+
+    /**
+     * The shared mutex this guard is locking/unlocking.
+     */
+    SharedMutex& m_sharedMutex;
+
+    bool m_didGetLock = false;
+};
+
+/**
+ * A RAII class that locks a SharedMutex for exclusive (write) access when constructed and unlocks it when destroyed.
+ */
+class SharedMutexWriteGuard {
+public:
+
+    ~SharedMutexWriteGuard();
+
+    // Prevent copying
+    SharedMutexWriteGuard(const SharedMutexWriteGuard&) = delete;
+    SharedMutexWriteGuard& operator=(const SharedMutexWriteGuard&) = delete;
+    SharedMutexWriteGuard(SharedMutexWriteGuard&& other);
+    SharedMutexWriteGuard& operator=(SharedMutexWriteGuard&&) = delete;
+
+    /**
+     * \brief Check if the shared mutex was successfully locked with this guard.
+     * 
+     * \return True if the shared mutex was successfully locked with this guard, false otherwise.
+     */
+    bool didGetLock() const;
+
+    // Allow SharedMutex to construct SharedMutexWriteGuard objects
+    friend class SharedMutex;
+
+protected:
+    /**
+     * \brief Constructor is hidden since we only want to allow the SharedMutex class to construct guard objects.
+     */
+    SharedMutexWriteGuard(SharedMutex& sharedMutex, k_timeout_t timeout);
+
+    /**
+     * The shared mutex this guard is locking/unlocking.
+     */
+    SharedMutex& m_sharedMutex;
+
+    bool m_didGetLock = false;
+};
+
+/**
+ * A reader-writer lock. Any number of threads can hold it for reading at the same time, but only one thread can hold
+ * it for writing, and only when no threads are reading.
+ * 
+ * Use this instead of zct::Mutex for data which is read often from multiple threads but rarely written, so that
+ * readers do not block each other.
+ * 
+ * Lock it with readGuard() or writeGuard(), which return RAII guards in the same way as Mutex::lockGuard().
+ * 
+ * Options:
+ * - **Preference:** With Preference::Writer (the default), new readers wait once a writer is waiting, so a steady
+ *   stream of readers can't starve writers. With Preference::Reader, readers only wait while a writer holds the lock.
+ * - **Priority inheritance:** When enabled, the writer holds a Zephyr mutex for as long as it holds the lock, and
+ *   readers briefly lock that mutex before reading. A high priority reader or writer waiting on a low priority writer then
+ *   raises the priority of the writer, just like with zct::Mutex. Readers have no single owner, so a writer waiting on
+ *   readers does not raise their priority. Because readers pass through the writer mutex, a waiting writer also holds
+ *   back new readers, so Preference::Reader behaves like Preference::Writer when this is enabled.
+ * 
+ * Just like zct::Mutex, this is not designed for use in interrupts.
+ */
+class SharedMutex {
+public:
+
+    /** Who gets the lock first when both readers and writers are waiting. */
+    enum class Preference {
+        Reader,
+        Writer,
+    };
+
+    /**
+     * \brief Construct a new shared mutex. It starts off unlocked.
+     * 
+     * \param preference Whether waiting writers block new readers. See the class description.
+     * \param isPriorityInheritance Whether to raise the priority of a writer which is blocking higher priority threads.
+     */
+    SharedMutex(Preference preference = Preference::Writer, bool isPriorityInheritance = false);
+
+    /**
+     * \brief Destroy the shared mutex.
+     */
+    ~SharedMutex();
+
+    /**
+     * \brief Lock the shared mutex for reading and get a guard which unlocks it when it goes out of scope.
+     * 
+     * Note that this function may fail to lock the shared mutex. It is the callers responsibility to check if the lock was
+     * successful with didGetLock() after making this call.
+     * 
+     * \param timeout The timeout for the lock. Pass K_FOREVER to wait indefinitely, or K_NO_WAIT to not wait at all.
+     * \return A read guard for this shared mutex.
+     */
+    SharedMutexReadGuard readGuard(k_timeout_t timeout);
+
+    /**
+     * \brief Lock the shared mutex for writing and get a guard which unlocks it when it goes out of scope.
+     * 
+     * Note that this function may fail to lock the shared mutex. It is the callers responsibility to check if the lock was
+     * successful with didGetLock() after making this call.
+     * 
+     * \param timeout The timeout for the lock. Pass K_FOREVER to wait indefinitely, or K_NO_WAIT to not wait at all.
+     * \return A write guard for this shared mutex.
+     */
+    SharedMutexWriteGuard writeGuard(k_timeout_t timeout);
+
+    /**
+     * \brief Get the number of threads currently holding the lock for reading.
+     * 
+     * \return The number of readers.
+     */
+    uint32_t getNumReaders();
+
+    // Allow the guards to lock and unlock the shared mutex
+    friend class SharedMutexReadGuard;
+    friend class SharedMutexWriteGuard;
+
+protected:
+
+    /**
+     * Lock for reading.
+     * 
+     * \param timeout The timeout for the lock.
+     * \return 0 on success, -EAGAIN if the timeout expired.
+     */
+    int lockRead(k_timeout_t timeout);
+
+    /** Unlock after lockRead(). */
+    void unlockRead();
+
+    /**
+     * Lock for writing.
+     * 
+     * \param timeout The timeout for the lock.
+     * \return 0 on success, -EAGAIN if the timeout expired.
+     */
+    int lockWrite(k_timeout_t timeout);
+
+    /** Unlock after lockWrite(). */
+    void unlockWrite();
+
+    Preference m_preference;
+    bool m_isPriorityInheritance;
+
+    /** Protects the state below. Only held briefly, never while the shared mutex is held. */
+    struct k_mutex m_stateMutex;
+
+    /** Readers wait on this for the writer to finish. */
+    struct k_condvar m_readersCondVar;
+
+    /** Writers wait on this for readers and the other writer to finish. */
+    struct k_condvar m_writersCondVar;
+
+    /** Held by the writer for as long as it holds the lock, if priority inheritance is enabled. */
+    struct k_mutex m_writerMutex;
+
+    uint32_t m_numReaders = 0;
+    uint32_t m_numWaitingWriters = 0;
+    bool m_isWriterActive = false;
+};
+
+} // namespace zct
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+namespace zct {
+
+/**
+ * Hands out slot indexes in the range [0, N) from a bitset, with no heap usage. Useful for managing a fixed table of
+ * objects, e.g. connection handles or channel IDs.
+ * 
+ * allocate() and free() are lock-free, so they can be called from any thread or ISR.
+ * 
+ * \tparam N The number of slots.
+ */
+template<size_t N>
+class SlotAllocator {
+public:
+
+    /**
+     * \brief Create an allocator with every slot free.
+     */
+    constexpr SlotAllocator() = default;
+
+    // Prevent copying, the bits may be changing concurrently
+    SlotAllocator(const SlotAllocator&) = delete;
+    SlotAllocator& operator=(const SlotAllocator&) = delete;
+
+    /**
+     * \brief Allocate the lowest free slot.
+     * 
+     * THREAD SAFE.
+     * 
+     * \return The slot index, or -ENOMEM if every slot is in use.
+     */
+    int allocate()
+    {
+        for (size_t slot = 0; slot < N; slot++) {
+            if (!atomic_test_and_set_bit(m_bits, slot)) {
+                return static_cast<int>(slot);
+            }
+        }
+        return -ENOMEM;
+    }
+
+    /**
+     * \brief Free a slot so it can be allocated again.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param slot The slot index returned by allocate().
+     */
+    void free(int slot)
+    {
+        __ASSERT(slot >= 0 && static_cast<size_t>(slot) < N, "Slot %d out of range.", slot);
+        __ASSERT(isAllocated(slot), "Slot %d freed twice.", slot);
+        atomic_clear_bit(m_bits, slot);
+    }
+
+    /**
+     * \brief Check if a slot is allocated.
+     * 
+     * \param slot The slot index.
+     * \return True if the slot is allocated.
+     */
+    bool isAllocated(int slot) const
+    {
+        return atomic_test_bit(m_bits, slot);
+    }
+
+    /**
+     * \brief Get the number of slots currently allocated.
+     * 
+     * \return The number of allocated slots.
+     */
+    size_t getNumAllocated() const
+    {
+        size_t numAllocated = 0;
+        for (size_t word = 0; word < ATOMIC_BITMAP_SIZE(N); word++) {
+            numAllocated += static_cast<size_t>(__builtin_popcountl(static_cast<unsigned long>(atomic_get(&m_bits[word]))));
+        }
+        return numAllocated;
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+protected:
+    ATOMIC_DEFINE(m_bits, N) = {};
+};
+
+} // namespace zct
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+namespace zct {
+
+// Forward declarations
+class SpinLock;
+
+/**
+ * A RAII class that locks a SpinLock when constructed and unlocks it when destroyed.
+ * 
+ * Unlike MutexLockGuard, locking a spinlock cannot fail, so there is no didGetLock().
+ */
+class SpinLockGuard {
+public:
+
+    ~SpinLockGuard();
+
+    // Prevent copying
+    SpinLockGuard(const SpinLockGuard&) = delete;
+    SpinLockGuard& operator=(const SpinLockGuard&) = delete;
+    SpinLockGuard(SpinLockGuard&& other);
+    SpinLockGuard& operator=(SpinLockGuard&&) = delete;
+
+    // Allow SpinLock to construct SpinLockGuard objects
+    friend class SpinLock;
+
+protected:
+    /**
+     * \brief Constructor is hidden since we only want to allow the SpinLock class to construct SpinLockGuard objects.
+     */
+    explicit SpinLockGuard(SpinLock& spinLock);
+
+    /**
+     * The spinlock this guard is locking/unlocking. nullptr once moved from.
+     */
+    SpinLock* m_spinLock;
+
+    /**
+     * The key returned by k_spin_lock(), which restores the interrupt state on unlock.
+     */
+    k_spinlock_key_t m_key;
+};
+
+/**
+ * A wrapper around a Zephyr spinlock.
+ * 
+ * Unlike zct::Mutex, this can be used from interrupts, e.g. to protect data shared between a GpioReal interrupt
+ * callback and a thread. Locking masks interrupts on the current CPU and, on SMP, spins until the lock is free,
+ * so keep the critical sections short and never block while holding it.
+ * 
+ * In debug builds (CONFIG_ASSERT=y) the hold time of every lock is measured with the cycle counter, and the
+ * longest one is available from getMaxHoldTime_cycles(). This helps find critical sections which add interrupt
+ * latency. In release builds the measurement compiles out.
+ * 
+ * Example:
+ * \code
+ * zct::SpinLock spinLock;
+ * {
+ *     auto guard = spinLock.lockGuard();
+ *     // Access data shared with an ISR
+ * } // guard goes out of scope, so the spinlock is unlocked and interrupts are restored
+ * \endcode
+ */
+class SpinLock {
+public:
+
+    SpinLock() = default;
+
+    // A spinlock cannot be copied or moved while it might be held
+    SpinLock(const SpinLock&) = delete;
+    SpinLock& operator=(const SpinLock&) = delete;
+
+    /**
+     * \brief Lock the spinlock and get a guard which unlocks it when it goes out of scope.
+     * 
+     * Safe to call from interrupts. Must not be called while already holding this spinlock.
+     * 
+     * \return A lock guard for this spinlock.
+     */
+    SpinLockGuard lockGuard()
+    {
+        return SpinLockGuard(*this);
+    }
+
+    /**
+     * \brief Get the longest time the spinlock has been held for.
+     * 
+     * \return The max hold time in cycles of the kernel cycle counter, or 0 if CONFIG_ASSERT is not enabled.
+     */
+    uint32_t getMaxHoldTime_cycles() const
+    {
+        return m_maxHoldTime_cycles;
+    }
+
+    /**
+     * \brief Reset the max hold time back to 0.
+     */
+    void resetMaxHoldTime()
+    {
+        m_maxHoldTime_cycles = 0;
+    }
+
+    /**
+     * \brief Get the underlying Zephyr spinlock, for passing to Zephyr APIs.
+     * 
+     * \return The Zephyr spinlock.
+     */
+    struct k_spinlock* getZephyrSpinLock()
+    {
+        return &m_spinLock;
+    }
+
+    // Allow SpinLockGuard to lock and unlock the spinlock
+    friend class SpinLockGuard;
+
+protected:
+
+    struct k_spinlock m_spinLock = {};
+
+    /** Longest hold time seen. Only written while the spinlock is held. */
+    uint32_t m_maxHoldTime_cycles = 0;
+
+#if defined(CONFIG_ASSERT) && CONFIG_ASSERT
+    /** When the current holder locked the spinlock. */
+    uint32_t m_lockTime_cycles = 0;
+#endif
+};
+
+//================================================================================================//
+// SpinLockGuard inline definitions
+//================================================================================================//
+
+// Defined in the header so that locking from an ISR doesn't cost a function call.
+
+inline SpinLockGuard::SpinLockGuard(SpinLock& spinLock)
+    : m_spinLock(&spinLock)
+{
+    m_key = k_spin_lock(&spinLock.m_spinLock);
+#if defined(CONFIG_ASSERT) && CONFIG_ASSERT
+    spinLock.m_lockTime_cycles = k_cycle_get_32();
+#endif
+}
+
+inline SpinLockGuard::SpinLockGuard(SpinLockGuard&& other)
+    : m_spinLock(other.m_spinLock),
+      m_key(other.m_key)
+{
+    // The lock now belongs to this guard
+    other.m_spinLock = nullptr;
+}
+
+inline SpinLockGuard::~SpinLockGuard()
+{
+    if (m_spinLock == nullptr) {
+        return;
+    }
+#if defined(CONFIG_ASSERT) && CONFIG_ASSERT
+    uint32_t holdTime_cycles = k_cycle_get_32() - m_spinLock->m_lockTime_cycles;
+    if (holdTime_cycles > m_spinLock->m_maxHoldTime_cycles) {
+        m_spinLock->m_maxHoldTime_cycles = holdTime_cycles;
+    }
+#endif
+    k_spin_unlock(&m_spinLock->m_spinLock, m_key);
+}
+
+} // namespace zct
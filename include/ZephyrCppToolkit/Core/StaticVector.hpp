@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <zephyr/kernel.h>
+
+namespace zct {
+
+/**
+ * A vector with a fixed capacity and no heap usage. The storage for all N items is part of the object, so the memory
+ * footprint is known at link time.
+ * 
+ * The API follows std::vector (so it works with range-based for loops and standard algorithms), except that adding
+ * an item fails rather than reallocating once the vector is full. push_back() returns false and emplace_back() returns
+ * nullptr in that case.
+ * 
+ * Items are only constructed when added, so T does not need to be default constructible.
+ * 
+ * \tparam T The type of item.
+ * \tparam N The maximum number of items.
+ */
+template<typename T, size_t N>
+class StaticVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * \brief Create an empty vector.
+     */
+    constexpr StaticVector() :
+        m_unused()
+    {
+    }
+
+    constexpr StaticVector(const StaticVector& other) :
+        m_unused()
+    {
+        for (const T& item : other) {
+            push_back(item);
+        }
+    }
+
+    constexpr StaticVector& operator=(const StaticVector& other)
+    {
+        if (this != &other) {
+            clear();
+            for (const T& item : other) {
+                push_back(item);
+            }
+        }
+        return *this;
+    }
+
+    constexpr ~StaticVector()
+    {
+        clear();
+    }
+
+    /**
+     * \brief Construct a new item in place at the end of the vector.
+     * 
+     * \param args Arguments forwarded to T's constructor.
+     * \return The new item, or nullptr if the vector is full.
+     */
+    template<typename... Args>
+    constexpr T* emplace_back(Args&&... args)
+    {
+        if (m_size >= N) {
+            return nullptr;
+        }
+        T* item = std::construct_at(&m_items[m_size], std::forward<Args>(args)...);
+        m_size++;
+        return item;
+    }
+
+    /**
+     * \brief Copy an item onto the end of the vector.
+     * 
+     * \param item The item to add.
+     * \return True on success, false if the vector is full.
+     */
+    constexpr bool push_back(const T& item)
+    {
+        return emplace_back(item) != nullptr;
+    }
+
+    /**
+     * \brief Move an item onto the end of the vector.
+     * 
+     * \param item The item to add.
+     * \return True on success, false if the vector is full.
+     */
+    constexpr bool push_back(T&& item)
+    {
+        return emplace_back(std::move(item)) != nullptr;
+    }
+
+    /**
+     * \brief Insert an item before pos, shifting later items up by one.
+     * 
+     * \param pos Where to insert the item. May be end().
+     * \param item The item to insert.
+     * \return An iterator to the inserted item, or end() if the vector is full.
+     */
+    constexpr iterator insert(const_iterator pos, T item)
+    {
+        size_t index = static_cast<size_t>(pos - begin());
+        __ASSERT(index <= m_size, "Insert position out of range.");
+        if (emplace_back(std::move(item)) == nullptr) {
+            return end();
+        }
+        // The new item went on the end, rotate it down into place
+        for (size_t i = m_size - 1; i > index; i--) {
+            std::swap(m_items[i], m_items[i - 1]);
+        }
+        return &m_items[index];
+    }
+
+    /**
+     * \brief Remove the item at pos, shifting later items down by one.
+     * 
+     * \param pos The item to remove.
+     * \return An iterator to the item after the removed one.
+     */
+    constexpr iterator erase(const_iterator pos)
+    {
+        size_t index = static_cast<size_t>(pos - begin());
+        __ASSERT(index < m_size, "Erase position out of range.");
+        for (size_t i = index; i + 1 < m_size; i++) {
+            m_items[i] = std::move(m_items[i + 1]);
+        }
+        pop_back();
+        return &m_items[index];
+    }
+
+    /**
+     * \brief Remove the last item. The vector must not be empty.
+     */
+    constexpr void pop_back()
+    {
+        __ASSERT(m_size > 0, "pop_back() called on empty vector.");
+        m_size--;
+        std::destroy_at(&m_items[m_size]);
+    }
+
+    /**
+     * \brief Remove all items.
+     */
+    constexpr void clear()
+    {
+        while (m_size > 0) {
+            pop_back();
+        }
+    }
+
+    constexpr T& operator[](size_t index)
+    {
+        __ASSERT(index < m_size, "Index %u out of range.", (unsigned)index);
+        return m_items[index];
+    }
+
+    constexpr const T& operator[](size_t index) const
+    {
+        __ASSERT(index < m_size, "Index %u out of range.", (unsigned)index);
+        return m_items[index];
+    }
+
+    constexpr T& front() { return (*this)[0]; }
+    constexpr const T& front() const { return (*this)[0]; }
+    constexpr T& back() { return (*this)[m_size - 1]; }
+    constexpr const T& back() const { return (*this)[m_size - 1]; }
+
+    constexpr T* data() { return m_items; }
+    constexpr const T* data() const { return m_items; }
+
+    constexpr iterator begin() { return m_items; }
+    constexpr iterator end() { return m_items + m_size; }
+    constexpr const_iterator begin() const { return m_items; }
+    constexpr const_iterator end() const { return m_items + m_size; }
+
+    constexpr size_t size() const { return m_size; }
+    static constexpr size_t capacity() { return N; }
+    constexpr bool empty() const { return m_size == 0; }
+    constexpr bool full() const { return m_size == N; }
+
+protected:
+
+    /**
+     * A union so that items are only constructed when added. m_unused is the active member until then, so that an
+     * empty vector counts as fully initialized and can be constant initialized.
+     */
+    union {
+        char m_unused;
+        T m_items[N];
+    };
+
+    size_t m_size = 0;
+};
+
+} // namespace zct
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <zephyr/kernel.h>
+
+namespace zct {
+
+/**
+ * \brief Reports stack usage and CPU load for a thread, and keeps a registry of all monitored threads.
+ * 
+ * Every zct::EventThread has a thread monitor (see EventThread::threadMonitor()), so all live event threads can be
+ * enumerated with forEach() or logged in one go with logAll(), e.g. from a periodic timer.
+ * 
+ * Stack usage requires `CONFIG_THREAD_STACK_INFO=y` and `CONFIG_INIT_STACKS=y`. CPU load requires
+ * `CONFIG_THREAD_RUNTIME_STATS=y`. Statistics which are not available are reported as 0.
+ */
+class ThreadMonitor {
+public:
+
+    /** Statistics returned by getStats(). */
+    struct Stats {
+        size_t stackSize_bytes = 0;         ///< The size of the thread's stack.
+        size_t stackHighWater_bytes = 0;    ///< The most stack the thread has ever used.
+        uint64_t runtime_us = 0;            ///< The total time the thread has been running for.
+        uint8_t cpuLoad_percent = 0;        ///< The percentage of CPU time used by the thread since getStats() was last called.
+    };
+
+    /**
+     * Create a new thread monitor and add it to the registry.
+     * 
+     * The thread does not need to be running yet, call setThread() once it has been created.
+     * 
+     * \param name The name of the thread, used when logging.
+     * \param stackSize_bytes The size of the thread's stack. Only reported if CONFIG_THREAD_STACK_INFO is disabled, otherwise
+     *     the size recorded by the kernel is used.
+     */
+    ThreadMonitor(const char* name, size_t stackSize_bytes);
+
+    /**
+     * Remove the thread monitor from the registry.
+     */
+    ~ThreadMonitor();
+
+    // Prevent copying and moving, the registry holds a pointer to this object
+    ThreadMonitor(const ThreadMonitor&) = delete;
+    ThreadMonitor& operator=(const ThreadMonitor&) = delete;
+
+    /**
+     * Set the thread to monitor. Call this once the thread has been created.
+     * 
+     * \param thread The thread to monitor.
+     */
+    void setThread(struct k_thread* thread);
+
+    /**
+     * Get the current statistics for the thread.
+     * 
+     * This also resets the CPU load measurement window, so the next call reports the CPU load since this one.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param stats Populated with the statistics.
+     * \return 0 on success, -ESRCH if the thread has not been set yet.
+     */
+    int getStats(Stats& stats);
+
+    /**
+     * Get the name of the monitored thread.
+     * 
+     * \return The name passed to the constructor.
+     */
+    const char* getName() const;
+
+    /**
+     * Call a function for every thread monitor in the registry.
+     * 
+     * The registry is locked while iterating, so the function must not create or destroy thread monitors.
+     * 
+     * THREAD SAFE.
+     * 
+     * \param func The function to call.
+     */
+    static void forEach(const std::function<void(ThreadMonitor&)>& func);
+
+    /**
+     * Log the statistics of every thread monitor in the registry at info level. Designed to be called periodically.
+     * 
+     * THREAD SAFE.
+     */
+    static void logAll();
+
+protected:
+    const char* m_name;
+    size_t m_stackSize_bytes;
+    struct k_thread* m_thread = nullptr;
+
+    /** Runtime stats at the previous call to getStats(), used to calculate the CPU load. */
+    uint64_t m_lastThreadCycles = 0;
+    uint64_t m_lastTotalCycles = 0;
+
+    /** The next thread monitor in the registry. */
+    ThreadMonitor* m_next = nullptr;
+
+    /** The first thread monitor in the registry. */
+    static ThreadMonitor* s_first;
+};
+
+} // namespace zct
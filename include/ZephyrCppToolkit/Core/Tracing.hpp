@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * \file Tracing.hpp
+ * 
+ * Hooks which emit toolkit activity (event dispatch, timer expiry, mutex locking) into Zephyr's tracing
+ * subsystem as named events. With the CTF tracing backend these show up in tools like TraceCompass
+ * alongside the kernel's own thread switching records.
+ * 
+ * Tracing is opt-in. Set the `ZCT_TRACING` CMake option to `ON` and enable `CONFIG_TRACING` in your
+ * `prj.conf`. If either is not enabled, every hook compiles out to nothing.
+ * 
+ * The following named events are emitted. Where an argument is a thread, it is the address of the Zephyr
+ * `k_thread` object (truncated to 32 bits), which is the same thread ID the CTF backend uses for its thread records.
+ * This ties the events to the thread names set in EventThread::start().
+ * 
+ * | Name                | arg0                      | arg1                                            |
+ * |---------------------|---------------------------|-------------------------------------------------|
+ * | `zct_enqueue`       | Event thread              | Event index, or ZCT_TRACE_FUNCTION for runInLoop() |
+ * | `zct_enqueue_fail`  | Event thread              | Return code from k_msgq_put(), after a `zct_enqueue` whose item was not queued |
+ * | `zct_dequeue`       | Event thread              | Number of items still in the queue              |
+ * | `zct_handler_start` | Event thread              | Event index, or ZCT_TRACE_FUNCTION for runInLoop() |
+ * | `zct_handler_end`   | Event thread              | Same as `zct_handler_start`                     |
+ * | `zct_timer_fire`    | Event thread              | Timer                                           |
+ * | `zct_timer_end`     | Event thread              | Timer                                           |
+ * | `zct_mutex_wait`    | Mutex                     | Timeout in ticks                                |
+ * | `zct_mutex_locked`  | Mutex                     | Return code from k_mutex_lock()                 |
+ * | `zct_mutex_unlock`  | Mutex                     | 0                                               |
+ */
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+#if defined(ZCT_TRACING) && ZCT_TRACING && defined(CONFIG_TRACING)
+#include <zephyr/tracing/tracing.h>
+
+/**
+ * Emit a named event into the Zephyr tracing subsystem. Compiles out if tracing is disabled.
+ * 
+ * \param name The name of the event. Keep this under 20 characters so it is not truncated by the CTF backend.
+ * \param arg0 First argument, converted to uint32_t.
+ * \param arg1 Second argument, converted to uint32_t.
+ */
+#define ZCT_TRACE(name, arg0, arg1) \
+    sys_trace_named_event((name), (uint32_t)(uintptr_t)(arg0), (uint32_t)(uintptr_t)(arg1))
+#else
+#define ZCT_TRACE(name, arg0, arg1) do { } while (0)
+#endif
+
+/** Used as the event index in traces when a function passed to runInLoop() is queued or run. */
+#define ZCT_TRACE_FUNCTION UINT32_MAX
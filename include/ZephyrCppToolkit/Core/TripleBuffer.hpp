@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+namespace zct {
+
+/**
+ * A lock-free triple buffer, for handing the latest snapshot of a large struct from one producer to one consumer
+ * which run at different rates, e.g. a control loop publishing its state to a UI thread.
+ * 
+ * The producer writes into its own buffer and publishes it. The consumer picks up the most recently published buffer
+ * and reads it in place. The third buffer sits between them, so neither side ever blocks or copies the data, and
+ * the consumer always sees a complete frame. Frames the consumer does not get round to reading are skipped.
+ * 
+ * Only one thread (or ISR) may produce and only one may consume.
+ * 
+ * Example:
+ * \code
+ * zct::TripleBuffer<ControlState> stateBuffer;
+ * 
+ * // Producer
+ * ControlState& state = stateBuffer.getWriteBuffer();
+ * state.position = ...;
+ * stateBuffer.publish();
+ * 
+ * // Consumer
+ * if (stateBuffer.update()) {
+ *     const ControlState& state = stateBuffer.getReadBuffer();
+ *     // Draw state
+ * }
+ * \endcode
+ * 
+ * \tparam T The type of the data.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+
+    TripleBuffer() = default;
+
+    // Prevent copying, the indexes refer to this object's buffers
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * \brief Get the buffer the producer should write the next frame into.
+     * 
+     * Producer only. The buffer still holds whatever was last written into it, not the last published frame.
+     * 
+     * \return The producer's buffer.
+     */
+    T& getWriteBuffer()
+    {
+        return m_buffers[m_writeIndex];
+    }
+
+    /**
+     * \brief Publish the write buffer as the latest frame, and get a fresh buffer to write into.
+     * 
+     * Producer only. Never blocks.
+     */
+    void publish()
+    {
+        atomic_val_t oldShared = atomic_set(&m_shared, m_writeIndex | IS_NEW_FLAG);
+        m_writeIndex = static_cast<uint8_t>(oldShared & INDEX_MASK);
+    }
+
+    /**
+     * \brief Pick up the latest published frame, if there is one the consumer hasn't seen yet.
+     * 
+     * Consumer only. Never blocks.
+     * 
+     * \return True if getReadBuffer() now refers to a new frame, false if nothing new has been published.
+     */
+    bool update()
+    {
+        if ((atomic_get(&m_shared) & IS_NEW_FLAG) == 0) {
+            return false;
+        }
+        atomic_val_t oldShared = atomic_set(&m_shared, m_readIndex);
+        m_readIndex = static_cast<uint8_t>(oldShared & INDEX_MASK);
+        return true;
+    }
+
+    /**
+     * \brief Get the frame picked up by the last call to update().
+     * 
+     * Consumer only. The frame stays valid and unchanged until update() is called again.
+     * 
+     * \return The consumer's buffer.
+     */
+    const T& getReadBuffer() const
+    {
+        return m_buffers[m_readIndex];
+    }
+
+protected:
+
+    static constexpr atomic_val_t INDEX_MASK = 0x3;
+    static constexpr atomic_val_t IS_NEW_FLAG = 0x4;
+
+    T m_buffers[3] = {};
+
+    /** Owned by the producer. */
+    uint8_t m_writeIndex = 0;
+
+    /** The buffer in the middle, plus IS_NEW_FLAG if it holds a frame the consumer hasn't picked up. */
+    atomic_t m_shared = ATOMIC_INIT(1);
+
+    /** Owned by the consumer. */
+    uint8_t m_readIndex = 2;
+};
+
+} // namespace zct
@@ -0,0 +1,234 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <cstdint>
+#include <functional>
+
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Core/Arena.hpp"
+#include "Timer.hpp"
+#include "TimerManager.hpp"
+
+//================================================================================================//
+// MACROS
+//================================================================================================//
+
+// Don't use constexpr here, it seg faults!
+// static constexpr int LOG_LEVEL = LOG_LEVEL_DBG;
+#define ZCT_CALENDAR_SCHEDULER_LOG_LEVEL LOG_LEVEL_WRN
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief Calls functions at wall-clock times, e.g. "every day at 03:00" or "every hour on the hour".
+ * 
+ * Rules are cron-like: each rule has a set of allowed minutes, hours, days of the month, months and weekdays, and is
+ * due at every minute which matches all of them. Times are in UTC.
+ * 
+ * The scheduler uses a single zct::Timer registered with the timer manager of your event thread, which is only ever
+ * armed for the rule which is due next. Rule callbacks are called from the event thread, and nothing runs between
+ * rules being due.
+ * 
+ * The scheduler does not know the wall-clock time until setTime() is called (e.g. once the time has been received
+ * from the network or read from an RTC). Nothing is scheduled until then. Call setTime() again whenever the time base is
+ * corrected. Rules that become due in a period that is skipped over by moving the time forwards are not called.
+ * 
+ * All functions must be called from the event thread which owns the timer manager (use EventThread::runInLoop()
+ * to call them from elsewhere).
+ * 
+ * Dynamically allocates memory for the rules in the constructor.
+ */
+class CalendarScheduler {
+public:
+
+    /** Bits for Rule::weekdays. */
+    enum Weekday : uint8_t {
+        SUNDAY = 1 << 0,
+        MONDAY = 1 << 1,
+        TUESDAY = 1 << 2,
+        WEDNESDAY = 1 << 3,
+        THURSDAY = 1 << 4,
+        FRIDAY = 1 << 5,
+        SATURDAY = 1 << 6,
+        WEEKDAYS = MONDAY | TUESDAY | WEDNESDAY | THURSDAY | FRIDAY,
+        WEEKEND = SATURDAY | SUNDAY,
+        EVERY_DAY = WEEKDAYS | WEEKEND,
+    };
+
+    /**
+     * When a rule is due. A rule is due at every minute which matches all of the fields.
+     */
+    struct Rule {
+        /** Bit n set means minute n (0-59) matches. */
+        uint64_t minutes = (1ULL << 60) - 1;
+        /** Bit n set means hour n (0-23) matches. */
+        uint32_t hours = (1UL << 24) - 1;
+        /** Bit n set means day n (1-31) of the month matches. */
+        uint32_t daysOfMonth = ((1UL << 31) - 1) << 1;
+        /** Bit n set means month n (1-12) matches. */
+        uint16_t months = ((1U << 12) - 1) << 1;
+        /** Combination of Weekday bits. */
+        uint8_t weekdays = EVERY_DAY;
+
+        /** Due at the start of every minute. */
+        static constexpr Rule everyMinute() {
+            return Rule{};
+        }
+
+        /** Due every hour at the given minute past the hour. */
+        static constexpr Rule hourly(uint32_t minute) {
+            Rule rule;
+            rule.minutes = 1ULL << minute;
+            return rule;
+        }
+
+        /** Due every day at the given time. */
+        static constexpr Rule daily(uint32_t hour, uint32_t minute) {
+            Rule rule = hourly(minute);
+            rule.hours = 1UL << hour;
+            return rule;
+        }
+
+        /** Due on the given weekdays (combination of Weekday bits) at the given time. */
+        static constexpr Rule weekly(uint8_t weekdays, uint32_t hour, uint32_t minute) {
+            Rule rule = daily(hour, minute);
+            rule.weekdays = weekdays;
+            return rule;
+        }
+    };
+
+    /**
+     * Create a new calendar scheduler.
+     * 
+     * @param timerManager The timer manager of the event thread to call the rule callbacks from.
+     * @param maxNumRules The maximum number of rules that can be added. Space for this many rules will be allocated from the arena.
+     * @param arena The arena to allocate from. If nullptr, the default arena is used, or the heap if there is none.
+     */
+    CalendarScheduler(TimerManager& timerManager, uint32_t maxNumRules, Arena* arena = nullptr);
+
+    ~CalendarScheduler();
+
+    /**
+     * Add a rule.
+     * 
+     * @param rule When to call the callback.
+     * @param callback The function to call when the rule is due. Called from the event thread.
+     * @return The ID of the rule (used with removeRule()) on success, -ENOMEM if the max. number of rules has been reached,
+     *         or -EINVAL if the rule can never be due (e.g. the 31st of February).
+     */
+    int addRule(const Rule& rule, std::function<void()> callback);
+
+    /**
+     * Remove a rule. The ID may be re-used by a rule added later.
+     * 
+     * @param ruleId The ID returned by addRule().
+     */
+    void removeRule(int ruleId);
+
+    /**
+     * Set the current wall-clock time. Rules are only scheduled once this has been called.
+     * 
+     * Can be called again at any time to correct the time base, in which case every rule is rescheduled from the new time.
+     * 
+     * @param unixTime_ms The current time in milliseconds since the Unix epoch (UTC).
+     */
+    void setTime(int64_t unixTime_ms);
+
+    /**
+     * Check if the wall-clock time has been set with setTime().
+     * 
+     * @return True if the time has been set.
+     */
+    bool isTimeSet() const;
+
+    /**
+     * Get the current wall-clock time.
+     * 
+     * @return The current time in milliseconds since the Unix epoch (UTC), or -1 if setTime() has not been called.
+     */
+    int64_t getTime() const;
+
+    /**
+     * Work out when a rule is next due.
+     * 
+     * @param rule The rule.
+     * @param afterUnixTime_s The time to search from. The returned time is always after this.
+     * @return The next time in seconds since the Unix epoch that the rule is due, or -1 if it is never due.
+     */
+    static int64_t findNextDueTime(const Rule& rule, int64_t afterUnixTime_s);
+
+protected:
+
+    /** Called when the timer expires. Calls the callbacks of all due rules and arms the timer for the next one. */
+    void onTimerExpiry();
+
+    /** Arm the timer for the rule which is due next, or stop it if no rules are scheduled. */
+    void armTimer();
+
+    struct RuleSlot {
+        Rule rule;
+        std::function<void()> callback;
+        /** When the rule is next due in seconds since the Unix epoch, or -1 if not scheduled. */
+        int64_t nextDueTime_s = -1;
+        bool isUsed = false;
+    };
+
+    /**
+     * Create a new calendar scheduler which stores its rules in memory owned by the caller. Used by
+     * StaticCalendarScheduler.
+     * 
+     * @param timerManager The timer manager of the event thread to call the rule callbacks from.
+     * @param rules Space for maxNumRules rules. Must outlive the scheduler.
+     * @param maxNumRules The maximum number of rules that can be added.
+     */
+    CalendarScheduler(TimerManager& timerManager, RuleSlot* rules, uint32_t maxNumRules);
+
+    RuleSlot* m_rules;
+    uint32_t m_maxNumRules;
+
+    /** Where m_rules was allocated from, nullptr for the heap. */
+    Arena* m_arena;
+
+    /** False if m_rules is owned by a derived class, in which case it is not freed. */
+    bool m_isStorageOwned = true;
+
+    /** Wall-clock time minus uptime, in milliseconds. Only valid if m_isTimeSet is true. */
+    int64_t m_timeOffset_ms = 0;
+    bool m_isTimeSet = false;
+
+    /** Only ever armed for the rule which is due next. */
+    Timer m_timer;
+};
+
+/**
+ * A CalendarScheduler with space for MaxNumRules rules reserved inside the object, so no memory is allocated.
+ * 
+ * \tparam MaxNumRules The maximum number of rules that can be added.
+ */
+template<uint32_t MaxNumRules>
+class StaticCalendarScheduler : public CalendarScheduler {
+public:
+
+    /**
+     * Create a new calendar scheduler.
+     * 
+     * @param timerManager The timer manager of the event thread to call the rule callbacks from.
+     */
+    StaticCalendarScheduler(TimerManager& timerManager) :
+        CalendarScheduler(timerManager, m_storage, MaxNumRules)
+    {
+    }
+
+protected:
+    RuleSlot m_storage[MaxNumRules];
+};
+
+} // namespace zct
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <functional>
+#include <type_traits>
 #include <variant>
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include "../Core/Arena.hpp"
+#include "../Core/ThreadMonitor.hpp"
+#include "../Core/Tracing.hpp"
+#include "EventTraceRecorder.hpp"
+#include "PrecisionAlarm.hpp"
 #include "Timer.hpp"
 #include "TimerManager.hpp"
 
@@ -38,12 +44,17 @@ class EventThread {
 
 public:
 
+    /**
+     * Sent by wakeUp() to make the event loop re-check its timers. Carries nothing and is not passed to any handler.
+     */
+    struct WakeUp {};
+
     /**
      * The type of items that can be sent to the event thread. Can either be an event or a function to run in the context of the event thread.
      * 
-     * This is a variant of the event type and a function to run in the context of the event thread.
+     * This is a variant of the event type, a function to run in the context of the event thread, and the internal wake up item.
      */
-    using MsgQueueItem = std::variant<EventType, std::function<void()>>;
+    using MsgQueueItem = std::variant<EventType, std::function<void()>, WakeUp>;
 
     /**
      * Create a new event thread.
@@ -58,27 +69,34 @@ public:
      * @param threadStackSize The size of the stack provided.
      * @param threadPriority The priority to assign to the thread.
      * @param eventQueueBufferNumItems The number of items in the event queue.
+     * @param arena The arena to allocate the event queue buffer and timer manager from. If nullptr, the default arena is
+     *      used, or the heap if there is none.
      */
     EventThread(
         const char* name,
         k_thread_stack_t* threadStack,
         size_t threadStackSize,
         int threadPriority,
-        size_t eventQueueBufferNumItems
+        size_t eventQueueBufferNumItems,
+        Arena* arena = nullptr
     ) :
         m_threadStack(threadStack),
         m_threadStackSize(threadStackSize),
         m_threadPriority(threadPriority),
-        m_timerManager(10)
+        m_timerManager(10, arena),
+        m_threadMonitor(name, threadStackSize)
     {
         LOG_MODULE_DECLARE(EventThread, ZCT_EVENT_THREAD_LOG_LEVEL);
         LOG_DBG("EventThread constructor called.");
         m_name = name;
 
         // Create event queue buffer and then init queue with it
-        m_msgQueueBuffer = new MsgQueueItem[eventQueueBufferNumItems];
+        m_msgQueueBuffer = Arena::newArray<MsgQueueItem>(Arena::resolve(arena), eventQueueBufferNumItems);
         __ASSERT_NO_MSG(m_msgQueueBuffer != nullptr);
         k_msgq_init(&m_threadMsgQueue, (char*)m_msgQueueBuffer, sizeof(MsgQueueItem), eventQueueBufferNumItems);
+
+        // Timers started or stopped from other threads/ISRs need to wake the event loop so that it recalculates how long to block for
+        m_timerManager.setWakeCallback([this]() { wakeUp(); });
     };
 
     /**
@@ -105,7 +123,8 @@ public:
         LOG_MODULE_DECLARE(EventThread, ZCT_EVENT_THREAD_LOG_LEVEL);
         LOG_DBG("EventThread start() called.");
         
-        // Start the thread
+        // Create the thread but don't let it run until it has been named, so that everything it does
+        // (including any trace records) is associated with the name
         k_thread_create(
             &m_thread,
             m_threadStack,
@@ -116,9 +135,11 @@ public:
             NULL,
             m_threadPriority,
             0,
-            K_NO_WAIT);
+            K_FOREVER);
         // Name the thread for easier debugging/logging
         k_thread_name_set(&m_thread, m_name);
+        k_thread_start(&m_thread);
+        m_threadMonitor.setThread(&m_thread);
     }
 
     /**
@@ -145,7 +166,12 @@ public:
      */
     void sendEvent(const EventType& event) {
         MsgQueueItem item = event;
-        k_msgq_put(&m_threadMsgQueue, &item, K_NO_WAIT);
+        // Trace before queueing, otherwise the event thread could pre-empt us and run the handler first
+        ZCT_TRACE("zct_enqueue", &m_thread, getEventIndex(event));
+        int rc = k_msgq_put(&m_threadMsgQueue, &item, K_NO_WAIT);
+        if (rc != 0) {
+            ZCT_TRACE("zct_enqueue_fail", &m_thread, rc);
+        }
     }
 
     /**
@@ -164,6 +190,18 @@ public:
         return m_timerManager;
     }
 
+    /**
+     * Get the thread monitor for this event thread. Use this to get the stack high-water mark and CPU load of the thread.
+     * 
+     * All event threads are also registered with the thread monitor registry, see ThreadMonitor::forEach() and
+     * ThreadMonitor::logAll().
+     * 
+     * \return A reference to the thread monitor for this event thread.
+     */
+    ThreadMonitor& threadMonitor() {
+        return m_threadMonitor;
+    }
+
     /**
      * Exit the event loop. This will cause runEventLoop() to return.
      * This function must be called from the event thread context (i.e. from a timer
@@ -189,11 +227,99 @@ public:
      * 
      * THREAD SAFE. INTERRUPT SAFE.
      * 
-     * \param func The function to run. This will be run in the context of the event thread.
+     * \param func The function to run. This will be run in the context of the event thread. Must not be empty.
      */
     void runInLoop(std::function<void()> func) {
+        __ASSERT(func, "Function passed to runInLoop() must not be empty.");
         MsgQueueItem item = func;
-        k_msgq_put(&m_threadMsgQueue, &item, K_NO_WAIT);
+        // Trace before queueing, otherwise the event thread could pre-empt us and run the handler first
+        ZCT_TRACE("zct_enqueue", &m_thread, ZCT_TRACE_FUNCTION);
+        int rc = k_msgq_put(&m_threadMsgQueue, &item, K_NO_WAIT);
+        if (rc != 0) {
+            ZCT_TRACE("zct_enqueue_fail", &m_thread, rc);
+        }
+    }
+
+    /**
+     * Set the processing budget for each iteration of the event loop.
+     *
+     * By default (a budget of 0), the event loop handles a single queue item and then re-checks the timers.
+     * With a budget set, the event loop will keep handling queue items without re-checking the timers until either
+     * the budget is used up, the next timer is due or the queue is empty. This reduces the timer bookkeeping done
+     * per queue item. The time until the next timer is only recalculated when a handler starts, stops or moves a timer,
+     * so a timer is never delayed by the drain itself, only by the handler running when it becomes due (as it would be
+     * without a budget).
+     *
+     * Any single handler (timer callback, external event handler or function passed to runInLoop()) which takes
+     * longer than the budget is reported with a log warning naming the handler, and counted (see getNumBudgetOverruns()).
+     *
+     * This should be called before start() is called.
+     *
+     * \param budget_us The processing budget in microseconds. Set to 0 to disable the budget.
+     */
+    void setProcessingBudget(uint32_t budget_us) {
+        m_processingBudget_us = budget_us;
+    }
+
+    /**
+     * Get the number of times a handler has exceeded the processing budget set with setProcessingBudget().
+     *
+     * \return The number of budget overruns.
+     */
+    uint32_t getNumBudgetOverruns() const {
+        return m_numBudgetOverruns;
+    }
+
+    /**
+     * Attach a trace recorder to this event thread. Every timer expiry, external event and function passed
+     * to runInLoop() will be recorded just before it is dispatched.
+     *
+     * External events are recorded with their raw bytes as the payload if EventType is trivially copyable
+     * (which is the case for a std::variant of plain structs), so that they can be replayed
+     * later with zct::EventTraceReplayer.
+     *
+     * This should be called before start() is called.
+     *
+     * \param traceRecorder The recorder to use. Must exist for as long as it is attached. Set to nullptr to stop recording.
+     */
+    void setTraceRecorder(EventTraceRecorder* traceRecorder) {
+        m_traceRecorder = traceRecorder;
+    }
+
+    /**
+     * Use an alarm channel of a counter device to wake the event loop when the next timer is due, rather than the
+     * timeout of the message queue.
+     * 
+     * The message queue timeout is limited to the resolution of the system tick, so timers can be handled up to one
+     * tick late. Counter devices typically run much faster, so with a counter set timers are handled with
+     * microsecond-level jitter without having to shrink the system tick (see TimerManager::setSubTickPrecision()).
+     * The message queue timeout is still used as a backup, e.g. for delays too long for the counter.
+     * 
+     * Requires `CONFIG_COUNTER=y` and a 64-bit hardware cycle counter (`CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER`).
+     * 
+     * This should be called before start() is called.
+     * 
+     * \param counter The counter device, e.g. `DEVICE_DT_GET(DT_NODELABEL(counter0))`.
+     * \param channel The alarm channel of the counter to use. It must not be used by anything else.
+     * 
+     * \return 0 on success, -ENOTSUP if there is no 64-bit cycle counter, or the error from PrecisionAlarm::configure().
+     */
+    int setPrecisionCounter(const struct device* counter, uint8_t channel = 0) {
+        LOG_MODULE_DECLARE(EventThread, ZCT_EVENT_THREAD_LOG_LEVEL);
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+        // The alarm only has to wake the event loop, it then works out which timers have expired itself
+        int rc = m_precisionAlarm.configure(counter, channel, [this]() { wakeUp(); });
+        if (rc != 0) {
+            return rc;
+        }
+        m_timerManager.setSubTickPrecision(true);
+        return 0;
+#else
+        ARG_UNUSED(counter);
+        ARG_UNUSED(channel);
+        LOG_ERR("A 64-bit hardware cycle counter is needed to handle timers with sub-tick precision.");
+        return -ENOTSUP;
+#endif
     }
 
 protected:
@@ -209,7 +335,9 @@ protected:
         EventThread* obj = static_cast<EventThread*>(arg1);
         // Run the event loop. This should not return unless the user calls exitEventLoop().
         obj->runEventLoop();
-        // If we get here, the user decided to exit the thread
+        // If we get here, the user decided to exit the thread. Timers may still be running, so make sure the precision
+        // alarm can't fire and wake up an event thread which is about to be destroyed
+        obj->m_precisionAlarm.cancel();
     }
 
     /**
@@ -230,71 +358,224 @@ protected:
             // Get the next timer to expire
             auto nextTimerInfo = m_timerManager.getNextExpiringTimer();
 
-        // Check for expired timers and call their callbacks
-        while (nextTimerInfo.m_timer != nullptr && nextTimerInfo.m_durationToWaitUs == 0) {
-            LOG_DBG("Timer expired. Timer: %p.", nextTimerInfo.m_timer);
-            // Update the timer after expiry
-            nextTimerInfo.m_timer->updateAfterExpiry();
-            
-            // Call the callback
-            const auto& callback = nextTimerInfo.m_timer->getExpiryCallback();
-            if (callback) {
-                callback();
-                // If the callback calls exitEventLoop(), we will exit the event loop
-                // and return from runEventLoop().
-                if (m_exitEventLoop) {
-                    return;
+            // Check for expired timers and call their callbacks
+            while (nextTimerInfo.m_timer != nullptr && nextTimerInfo.m_durationToWaitUs == 0) {
+                LOG_DBG("Timer expired. Timer: %p.", nextTimerInfo.m_timer);
+                // Update the timer after expiry
+                nextTimerInfo.m_timer->updateAfterExpiry();
+                if (m_traceRecorder != nullptr) {
+                    m_traceRecorder->record(EventTraceRecorder::SourceType::Timer, reinterpret_cast<uintptr_t>(nextTimerInfo.m_timer), nullptr, 0);
                 }
+
+                // Call the callback, or pass the event of an event timer to the external event handler
+                const EventType* timerEvent = static_cast<const EventType*>(nextTimerInfo.m_timer->m_timerEvent);
+                const auto& callback = nextTimerInfo.m_timer->getExpiryCallback();
+                if (timerEvent != nullptr || callback) {
+                    uint32_t handlerStart_cyc = k_cycle_get_32();
+                    ZCT_TRACE("zct_timer_fire", &m_thread, nextTimerInfo.m_timer);
+                    if (timerEvent == nullptr) {
+                        callback();
+                    } else if (m_externalEventCallback) {
+                        // The event is already built, so it is dispatched straight from the timer without being copied
+                        // through the message queue
+                        m_externalEventCallback(*timerEvent);
+                    } else {
+                        LOG_WRN("Event timer \"%s\" expired in event thread \"%s\" but no external event callback is registered.",
+                            nextTimerInfo.m_timer->getName(), m_name);
+                    }
+                    ZCT_TRACE("zct_timer_end", &m_thread, nextTimerInfo.m_timer);
+                    uint32_t handlerDuration_us;
+                    if (isOverBudget(handlerStart_cyc, handlerDuration_us)) {
+                        LOG_WRN("Callback for timer \"%s\" in event thread \"%s\" took %u us, exceeding the processing budget of %u us.",
+                            nextTimerInfo.m_timer->getName(), m_name, handlerDuration_us, m_processingBudget_us);
+                    }
+                    // If the callback calls exitEventLoop(), we will exit the event loop
+                    // and return from runEventLoop().
+                    if (m_exitEventLoop) {
+                        return;
+                    }
+                }
+
+                // Check for the next expired timer
+                nextTimerInfo = m_timerManager.getNextExpiringTimer();
             }
-            
-            // Check for the next expired timer
-            nextTimerInfo = m_timerManager.getNextExpiringTimer();
-        }
 
-        // If we get here, we have handled all expired timers.
-        k_timeout_t timeout;
-        if (nextTimerInfo.m_timer != nullptr) {
-            timeout = Z_TIMEOUT_US(nextTimerInfo.m_durationToWaitUs);
-        } else {
-            timeout = K_FOREVER;
-        }
+            // If we get here, we have handled all expired timers.
+            k_timeout_t timeout;
+            if (nextTimerInfo.m_timer != nullptr) {
+                timeout = Z_TIMEOUT_US(nextTimerInfo.m_durationToWaitUs);
+                if (m_precisionAlarm.isConfigured()) {
+                    // Wakes us up (by putting an item in the queue) before the tick based timeout. If the delay is too
+                    // long for the counter, the timeout will wake us up and the alarm is armed again next time
+                    m_precisionAlarm.arm(nextTimerInfo.m_durationToWaitUs * 1000);
+                }
+            } else {
+                timeout = K_FOREVER;
+                if (m_precisionAlarm.isConfigured()) {
+                    m_precisionAlarm.cancel();
+                }
+            }
 
-        // Block on message queue until next timer expiry
-        // Create storage in the case we receive an external event
-        MsgQueueItem msgQueueItem;
-        int queueRc = k_msgq_get(&m_threadMsgQueue, &msgQueueItem, timeout);
-        if (queueRc == 0) {
-            // We got a message from the queue, it will either be an event or a function to run in the context of the event thread.
-            if (std::holds_alternative<EventType>(msgQueueItem)) {
-                // It's an event, call the external event callback
-                const auto& event = std::get<EventType>(msgQueueItem);
-                if (m_externalEventCallback) {
-                    m_externalEventCallback(event);
-                    // If the callback calls exitEventLoop(), we will exit the event loop
+            // Block on message queue until next timer expiry
+            // Create storage in the case we receive an external event
+            MsgQueueItem msgQueueItem;
+            int queueRc = k_msgq_get(&m_threadMsgQueue, &msgQueueItem, timeout);
+            if (queueRc == 0) {
+                // We got a message from the queue. If a processing budget is set, keep draining the queue
+                // until either the budget is used up, the next timer is due or a timer command is posted
+                // from another thread, whichever comes first.
+                // Then jump back to the start of the while loop so that timers get re-checked before we
+                // touch any more queue items.
+                uint32_t drainStart_cyc = k_cycle_get_32();
+                uint64_t drainLimit_us = 0;
+                uint32_t timerChangeCount = 0;
+                if (m_processingBudget_us != 0) {
+                    // Timers may have been started while we were blocked, so get a fresh expiry time
+                    drainLimit_us = calcDrainLimit(drainStart_cyc);
+                    timerChangeCount = m_timerManager.getChangeCount();
+                }
+                do {
+                    handleMsgQueueItem(msgQueueItem);
+                    // If the handler calls exitEventLoop(), we will exit the event loop
                     // and return from runEventLoop().
                     if (m_exitEventLoop) {
                         return;
                     }
+                    if (drainLimit_us != 0 && m_timerManager.getChangeCount() != timerChangeCount) {
+                        // The handler started, stopped or moved a timer, which may now be due before the drain limit
+                        drainLimit_us = calcDrainLimit(drainStart_cyc);
+                        timerChangeCount = m_timerManager.getChangeCount();
+                    }
+                } while (k_cyc_to_us_floor32(k_cycle_get_32() - drainStart_cyc) < drainLimit_us
+                         && !m_timerManager.hasPendingCommands()
+                         && k_msgq_get(&m_threadMsgQueue, &msgQueueItem, K_NO_WAIT) == 0);
+                continue;
+            } else if (queueRc == -EAGAIN) {
+                // Queue timed out, which means we need to handle the timer expiry,
+                // jump back to start of while loop to handle the timer expiry
+                LOG_DBG("Queue timed out, which means we need to handle timer expiry.");
+                continue;
+            } else if (queueRc == -ENOMSG) {
+                // This means the queue must have been purged
+                __ASSERT(false, "Got -ENOMSG from queue, was not expecting this.");
+            } else {
+                __ASSERT(false, "Got unexpected return code from queue: %d.", queueRc);
+            }
+        } // End of while (true) loop
+    }
+
+    /**
+     * Wake the event loop up if it is blocked on the message queue, without running anything. Used when timers are
+     * started or stopped from other threads/ISRs.
+     * 
+     * If the queue is full the event loop is not blocked, so failing to put the wake up item in the queue does not matter.
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     */
+    void wakeUp() {
+        MsgQueueItem item = WakeUp();
+        k_msgq_put(&m_threadMsgQueue, &item, K_NO_WAIT);
+    }
+
+    /**
+     * Handle a single item received from the message queue. The item will either be an event
+     * (passed to the external event callback), a function to run in the context of the event thread, or a wake up item
+     * from wakeUp() (ignored).
+     *
+     * \param msgQueueItem The item received from the message queue.
+     */
+    void handleMsgQueueItem(MsgQueueItem& msgQueueItem) {
+        LOG_MODULE_DECLARE(EventThread, ZCT_EVENT_THREAD_LOG_LEVEL);
+        ZCT_TRACE("zct_dequeue", &m_thread, k_msgq_num_used_get(&m_threadMsgQueue));
+        uint32_t handlerStart_cyc = k_cycle_get_32();
+        uint32_t handlerDuration_us;
+        if (std::holds_alternative<EventType>(msgQueueItem)) {
+            // It's an event, call the external event callback
+            const auto& event = std::get<EventType>(msgQueueItem);
+            if (m_traceRecorder != nullptr) {
+                // Only record the event bytes if they can be used to re-create the event on replay
+                if constexpr (std::is_trivially_copyable_v<EventType>) {
+                    m_traceRecorder->record(EventTraceRecorder::SourceType::Event, getEventIndex(event), &event, sizeof(EventType));
                 } else {
-                    LOG_WRN("Received external event in event thread \"%s\" but no external event callback is registered.", m_name);
+                    m_traceRecorder->record(EventTraceRecorder::SourceType::Event, getEventIndex(event), nullptr, 0);
+                }
+            }
+            if (m_externalEventCallback) {
+                ZCT_TRACE("zct_handler_start", &m_thread, getEventIndex(event));
+                m_externalEventCallback(event);
+                ZCT_TRACE("zct_handler_end", &m_thread, getEventIndex(event));
+                if (isOverBudget(handlerStart_cyc, handlerDuration_us)) {
+                    LOG_WRN("External event handler in event thread \"%s\" took %u us handling event index %u, exceeding the processing budget of %u us.",
+                        m_name, handlerDuration_us, getEventIndex(event), m_processingBudget_us);
                 }
             } else {
-                // It's a function to run in the context of the event thread, run it
-                std::get<std::function<void()>>(msgQueueItem)();
+                LOG_WRN("Received external event in event thread \"%s\" but no external event callback is registered.", m_name);
             }
-            continue;
-        } else if (queueRc == -EAGAIN) {
-            // Queue timed out, which means we need to handle the timer expiry,
-            // jump back to start of while loop to handle the timer expiry
-            LOG_DBG("Queue timed out, which means we need to handle timer expiry.");
-            continue;
-        } else if (queueRc == -ENOMSG) {
-            // This means the queue must have been purged
-            __ASSERT(false, "Got -ENOMSG from queue, was not expecting this.");
+        } else if (std::holds_alternative<WakeUp>(msgQueueItem)) {
+            // Only sent by wakeUp() to make the event loop re-check its timers. Nothing to run
+            return;
         } else {
-            __ASSERT(false, "Got unexpected return code from queue: %d.", queueRc);
+            // It's a function to run in the context of the event thread, run it
+            if (m_traceRecorder != nullptr) {
+                m_traceRecorder->record(EventTraceRecorder::SourceType::Function, 0, nullptr, 0);
+            }
+            ZCT_TRACE("zct_handler_start", &m_thread, ZCT_TRACE_FUNCTION);
+            std::get<std::function<void()>>(msgQueueItem)();
+            ZCT_TRACE("zct_handler_end", &m_thread, ZCT_TRACE_FUNCTION);
+            if (isOverBudget(handlerStart_cyc, handlerDuration_us)) {
+                LOG_WRN("Function passed to runInLoop() in event thread \"%s\" took %u us, exceeding the processing budget of %u us.",
+                    m_name, handlerDuration_us, m_processingBudget_us);
+            }
         }
-        } // End of while (true) loop
+    }
+
+    /**
+     * Get the index of an event in the event variant, for logging and tracing purposes.
+     *
+     * \param event The event.
+     * \return The index of the event if EventType is a std::variant (or anything else with an index() function), 0 otherwise.
+     */
+    static uint32_t getEventIndex(const EventType& event) {
+        if constexpr (requires { event.index(); }) {
+            return static_cast<uint32_t>(event.index());
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * Check if a handler has overrun the processing budget. Increments the overrun count if it has.
+     *
+     * \param handlerStart_cyc The cycle count when the handler was started.
+     * \param handlerDuration_us Set to the duration of the handler in microseconds.
+     * \return True if a processing budget is set and the handler took longer than it, false otherwise.
+     */
+    /**
+     * Calculate how long the event loop can keep draining the queue for, which is the processing budget or until the
+     * next timer is due, whichever is sooner.
+     *
+     * \param drainStart_cyc The cycle count when the drain started.
+     * \return The drain limit in microseconds, measured from drainStart_cyc.
+     */
+    uint64_t calcDrainLimit(uint32_t drainStart_cyc) {
+        uint64_t drainLimit_us = m_processingBudget_us;
+        auto nextTimerInfo = m_timerManager.getNextExpiringTimer();
+        if (nextTimerInfo.m_timer != nullptr) {
+            uint64_t timerDue_us = k_cyc_to_us_floor32(k_cycle_get_32() - drainStart_cyc) + nextTimerInfo.m_durationToWaitUs;
+            if (timerDue_us < drainLimit_us) {
+                drainLimit_us = timerDue_us;
+            }
+        }
+        return drainLimit_us;
+    }
+
+    bool isOverBudget(uint32_t handlerStart_cyc, uint32_t& handlerDuration_us) {
+        handlerDuration_us = k_cyc_to_us_floor32(k_cycle_get_32() - handlerStart_cyc);
+        if (m_processingBudget_us == 0 || handlerDuration_us <= m_processingBudget_us) {
+            return false;
+        }
+        m_numBudgetOverruns++;
+        return true;
     }
 
     const char* m_name = nullptr;
@@ -308,12 +589,31 @@ protected:
     int m_threadPriority;
 
     TimerManager m_timerManager;
+    ThreadMonitor m_threadMonitor;
+
+    /** Wakes the event loop when the next timer is due, if set up with setPrecisionCounter(). */
+    PrecisionAlarm m_precisionAlarm;
     std::function<void(const EventType&)> m_externalEventCallback = nullptr;
 
     /**
      * Used to signal from exitEventLoop() to the code in the runEventLoop() function to exit.
      */
     bool m_exitEventLoop = false;
+
+    /**
+     * The processing budget per loop iteration in microseconds. 0 means no budget is set. See setProcessingBudget().
+     */
+    uint32_t m_processingBudget_us = 0;
+
+    /**
+     * The number of times a handler has exceeded the processing budget.
+     */
+    uint32_t m_numBudgetOverruns = 0;
+
+    /**
+     * Records every dispatch if set. See setTraceRecorder().
+     */
+    EventTraceRecorder* m_traceRecorder = nullptr;
 };
 
 /**
@@ -0,0 +1,77 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include "EventThread.hpp"
+#include "Timer.hpp"
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief A timer which delivers a pre-built event to an event thread when it expires.
+ * 
+ * Rather than calling an expiry callback, the stored event is passed straight to the event thread's external event
+ * handler (see EventThread::onExternalEvent()), just like an event sent with EventThread::sendEvent() but without going
+ * through the message queue. The event is built once, so nothing is constructed, copied or allocated per expiry.
+ * 
+ * Use this when your event thread handles all its inputs in a single event handler (e.g. a state machine), so that timer
+ * expiries are just another event.
+ * 
+ * \code
+ * zct::EventTimer<Events::Generic> m_flashingTimer("FlashingTimer", m_eventThread, Events::TimerExpired());
+ * \endcode
+ * 
+ * Event timers can't be copied or moved, as the timer manager and event thread keep pointers to them.
+ */
+template <typename EventType>
+class EventTimer : public Timer {
+public:
+
+    /**
+     * Create a new event timer and register it with the event thread's timer manager.
+     * 
+     * The timer will not be running after creation.
+     * 
+     * \param name The name of the timer, used for logging purposes.
+     * \param eventThread The event thread to deliver the event to. The event type of the event thread must match.
+     * \param event The event to deliver when the timer expires. It is copied into the timer.
+     */
+    EventTimer(const char* name, EventThread<EventType>& eventThread, const EventType& event) :
+        Timer(name, nullptr, eventThread.timerManager()),
+        m_event(event)
+    {
+        m_timerEvent = &m_event;
+    }
+
+    EventTimer(const EventTimer&) = delete;
+    EventTimer& operator=(const EventTimer&) = delete;
+
+    /**
+     * Change the event delivered when the timer expires. Must be called from the event thread.
+     * 
+     * \param event The new event. It is copied into the timer.
+     */
+    void setEvent(const EventType& event) {
+        m_event = event;
+    }
+
+    /**
+     * Get the event delivered when the timer expires.
+     * 
+     * \return The event.
+     */
+    const EventType& getEvent() const {
+        return m_event;
+    }
+
+protected:
+    EventType m_event;
+};
+
+} // namespace zct
@@ -0,0 +1,163 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <cstdint>
+#include <cstddef>
+
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Core/Arena.hpp"
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+
+//================================================================================================//
+// MACROS
+//================================================================================================//
+
+// Don't use constexpr here, it seg faults!
+// static constexpr int LOG_LEVEL = LOG_LEVEL_DBG;
+#define ZCT_EVENT_TRACE_RECORDER_LOG_LEVEL LOG_LEVEL_WRN
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief Records every dispatch made by an zct::EventThread into a fixed-size RAM ring buffer.
+ * 
+ * Each record contains the time of the dispatch, what was dispatched (a timer expiry, an external event or
+ * a function passed to runInLoop()) and optionally the raw bytes of the event. Once the buffer is full the
+ * oldest records are overwritten.
+ * 
+ * Attach a recorder to an event thread with EventThread::setTraceRecorder(). Captured traces can be fed
+ * back into an event thread with zct::EventTraceReplayer.
+ * 
+ * Dynamically allocates memory for the ring buffer in the constructor.
+ */
+class EventTraceRecorder {
+public:
+
+    /** What caused a dispatch. */
+    enum class SourceType : uint8_t {
+        Timer,      ///< A timer expired. The source ID is the address of the zct::Timer.
+        Event,      ///< An external event was received. The source ID is the index of the event in the event variant.
+        Function,   ///< A function passed to runInLoop() was run. The source ID is always 0.
+    };
+
+    /** The fixed-size part of each record. */
+    struct RecordHeader {
+        int64_t timestamp_ticks;    ///< The system uptime in ticks when the dispatch occurred.
+        uintptr_t sourceId;         ///< Identifies the source, see SourceType.
+        SourceType sourceType;      ///< What caused the dispatch.
+        uint8_t payloadSize;        ///< Number of payload bytes stored with this record. 0 if no payload was recorded.
+    };
+
+    /**
+     * Create a new event trace recorder.
+     * 
+     * @param maxNumRecords The number of records the ring buffer can hold.
+     * @param maxPayloadSize The maximum number of payload bytes stored per record. Events larger than this
+     *                       are recorded without a payload. Set to 0 to never record payloads. Must be <= 255.
+     * @param arena The arena to allocate the ring buffer from. If nullptr, the default arena is used, or the heap if there is none.
+     */
+    EventTraceRecorder(size_t maxNumRecords, size_t maxPayloadSize, Arena* arena = nullptr);
+
+    ~EventTraceRecorder();
+
+    // Prevent copying and moving, the ring buffer is owned by this object
+    EventTraceRecorder(const EventTraceRecorder&) = delete;
+    EventTraceRecorder& operator=(const EventTraceRecorder&) = delete;
+
+    /**
+     * Add a record to the ring buffer. Overwrites the oldest record if the buffer is full.
+     * 
+     * Designed to be called by the event thread. Does nothing if recording is disabled.
+     * 
+     * @param sourceType What caused the dispatch.
+     * @param sourceId Identifies the source, see SourceType.
+     * @param payload Pointer to the payload bytes. Can be nullptr if payloadSize is 0.
+     * @param payloadSize The number of payload bytes. If larger than the max. payload size, no payload is stored.
+     */
+    void record(SourceType sourceType, uintptr_t sourceId, const void* payload, size_t payloadSize);
+
+    /**
+     * Get a copy of a record.
+     * 
+     * THREAD SAFE.
+     * 
+     * @param index The index of the record, where 0 is the oldest record still in the buffer.
+     * @param header Populated with the header of the record.
+     * @param payloadBuf Buffer to copy the payload into. Can be nullptr if you are not interested in the payload.
+     * @param payloadBufSize The size of payloadBuf. Must be at least header.payloadSize for the payload to be copied.
+     * @return true if the record exists, false if index is out of range.
+     */
+    bool getRecord(size_t index, RecordHeader& header, uint8_t* payloadBuf, size_t payloadBufSize) const;
+
+    /**
+     * Get the number of records currently stored.
+     * 
+     * @return The number of records, which will be at most the maxNumRecords passed to the constructor.
+     */
+    size_t getNumRecords() const;
+
+    /**
+     * Get the number of records that have been overwritten because the buffer was full.
+     * 
+     * @return The number of lost records since the last call to clear().
+     */
+    uint32_t getNumOverwrittenRecords() const;
+
+    /**
+     * Get the maximum number of payload bytes stored per record.
+     * 
+     * @return The max. payload size passed to the constructor.
+     */
+    size_t getMaxPayloadSize() const;
+
+    /**
+     * Enable or disable recording. Recording is enabled by default.
+     * 
+     * Disable recording before reading out a trace if you want a consistent snapshot.
+     * 
+     * @param isEnabled True to enable recording, false to disable.
+     */
+    void setEnabled(bool isEnabled);
+
+    /**
+     * Remove all records from the buffer.
+     */
+    void clear();
+
+protected:
+
+    /**
+     * Get a pointer to the start of the slot in the ring buffer for a record.
+     * 
+     * @param slot The slot index, in the range [0, m_maxNumRecords).
+     * @return Pointer to the header of the record in that slot.
+     */
+    uint8_t* getSlot(size_t slot) const;
+
+    uint8_t* m_buffer = nullptr;
+    size_t m_maxNumRecords;
+    size_t m_maxPayloadSize;
+    size_t m_slotSize;
+
+    /** Where m_buffer was allocated from, nullptr for the heap. */
+    Arena* m_arena;
+
+    /** The slot the next record will be written to. */
+    size_t m_head = 0;
+    size_t m_numRecords = 0;
+    uint32_t m_numOverwrittenRecords = 0;
+    bool m_isEnabled = true;
+
+    /** Protects the ring buffer so that it can be read from other threads while recording. */
+    mutable SpinLock m_lock;
+};
+
+} // namespace zct
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "EventThread.hpp"
+#include "EventTraceRecorder.hpp"
+
+namespace zct {
+
+/**
+ * \brief Feeds the external events captured by a zct::EventTraceRecorder back into an zct::EventThread.
+ * 
+ * Events are sent to the event thread at the same relative times at which they were originally dispatched.
+ * Timer expiries in the trace are not injected, the timers in the event thread under test will expire by
+ * themselves when the same events are received at the same times. Functions passed to runInLoop() cannot
+ * be replayed and are skipped.
+ * 
+ * This is designed to be used on `native_sim`, where the kernel clock is simulated. The replay then runs
+ * as fast as the host allows and yet every event is delivered at exactly the recorded tick, making the sequence
+ * of timer expiries and events deterministic. Attach a second recorder to the event thread under test to
+ * compare the resulting sequence with the captured one, or to profile it offline.
+ * 
+ * \code
+ * zct::EventTraceReplayer<MyEvents::Generic> replayer(capturedTrace, myEventThread);
+ * replayer.replay();
+ * \endcode
+ */
+template <typename EventType>
+class EventTraceReplayer {
+    static_assert(std::is_trivially_copyable_v<EventType>, "Events can only be replayed if EventType is trivially copyable.");
+
+public:
+
+    /**
+     * Create a new replayer.
+     * 
+     * \param trace The trace to replay. Recording should be disabled on this recorder while replaying.
+     * \param eventThread The event thread to send the events to. It should be started before calling replay().
+     */
+    EventTraceReplayer(const EventTraceRecorder& trace, EventThread<EventType>& eventThread) :
+        m_trace(trace),
+        m_eventThread(eventThread)
+    {
+    }
+
+    /**
+     * Replay the trace. Blocks the calling thread until all events have been sent.
+     * 
+     * The first record in the trace is aligned to the uptime when this is called, and every event is sent
+     * at the same offset from the first record as it was originally dispatched.
+     * 
+     * \return The number of events sent to the event thread.
+     */
+    size_t replay() {
+        LOG_MODULE_DECLARE(EventThread, ZCT_EVENT_THREAD_LOG_LEVEL);
+        EventTraceRecorder::RecordHeader header;
+        size_t numEventsSent = 0;
+        int64_t replayStart_ticks = k_uptime_ticks();
+        int64_t traceStart_ticks = 0;
+        alignas(EventType) uint8_t payloadBuf[sizeof(EventType)];
+
+        for (size_t i = 0; m_trace.getRecord(i, header, payloadBuf, sizeof(payloadBuf)); i++) {
+            if (i == 0) {
+                traceStart_ticks = header.timestamp_ticks;
+            }
+            if (header.sourceType != EventTraceRecorder::SourceType::Event) {
+                continue;
+            }
+            if (header.payloadSize != sizeof(EventType)) {
+                LOG_WRN("Trace record %zu has no usable payload, skipping.", i);
+                continue;
+            }
+
+            // Wait until the same offset into the replay as the event had into the trace
+            k_sleep(K_TIMEOUT_ABS_TICKS(replayStart_ticks + (header.timestamp_ticks - traceStart_ticks)));
+
+            EventType event;
+            memcpy(&event, payloadBuf, sizeof(EventType));
+            m_eventThread.sendEvent(event);
+            numEventsSent++;
+        }
+        return numEventsSent;
+    }
+
+protected:
+    const EventTraceRecorder& m_trace;
+    EventThread<EventType>& m_eventThread;
+};
+
+} // namespace zct
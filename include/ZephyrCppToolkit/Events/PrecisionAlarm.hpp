@@ -0,0 +1,105 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <cstdint>
+#include <functional>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+//================================================================================================//
+// MACROS
+//================================================================================================//
+
+// Don't use constexpr here, it seg faults!
+// static constexpr int LOG_LEVEL = LOG_LEVEL_DBG;
+#define ZCT_PRECISION_ALARM_LOG_LEVEL LOG_LEVEL_WRN
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief Calls a function from an ISR after a delay, using an alarm channel of a Zephyr counter device.
+ * 
+ * Counter devices typically run much faster than the system tick, so this can be used to wake a thread with
+ * microsecond precision without shrinking the system tick. zct::EventThread uses this to wake its event loop
+ * when the next timer is due, see EventThread::setPrecisionCounter().
+ * 
+ * Requires `CONFIG_COUNTER=y`. Without it, configure() returns -ENOTSUP.
+ */
+class PrecisionAlarm {
+public:
+
+    /**
+     * Create an alarm which is not yet configured. Call configure() before arming it.
+     */
+    PrecisionAlarm();
+
+    /**
+     * Cancel the alarm if it is armed, so the callback is not called after this object has been destroyed.
+     */
+    ~PrecisionAlarm();
+
+    /**
+     * Set the counter device and alarm channel to use and start the counter.
+     * 
+     * @param counter The counter device. Must exist for the lifetime of this object.
+     * @param channel The alarm channel of the counter to use. The channel must not be used by anything else.
+     * @param callback Called from the counter ISR when the alarm expires.
+     * @return 0 on success, -ENODEV if the counter is not ready, -EINVAL if the channel does not exist or the counter
+     *         has no fixed frequency, -ENOTSUP if counter support is not enabled, or the error from counter_start().
+     */
+    int configure(const struct device* counter, uint8_t channel, std::function<void()> callback);
+
+    /**
+     * Check if configure() has been called successfully.
+     * 
+     * @return True if the alarm can be armed.
+     */
+    bool isConfigured() const;
+
+    /**
+     * Arm the alarm to expire after a delay. Any previously armed alarm is cancelled first.
+     * 
+     * The delay is rounded up to the next counter tick, so the alarm never expires early.
+     * 
+     * @param delay_ns The delay from now in nanoseconds.
+     * @return 0 on success, -ERANGE if the delay is too long for the counter, or the error from counter_set_channel_alarm().
+     */
+    int arm(uint64_t delay_ns);
+
+    /**
+     * Cancel the alarm if it is armed.
+     */
+    void cancel();
+
+protected:
+
+    /** The function passed to the counter API, forwards the alarm to m_callback. */
+    static void staticAlarmCallback(const struct device* counter, uint8_t channel, uint32_t ticks, void* userData);
+
+    const struct device* m_counter = nullptr;
+    uint8_t m_channel = 0;
+
+    /** The frequency of the counter in Hz, cached so arm() does not need to ask the driver. */
+    uint32_t m_frequency_hz = 0;
+
+    /** The longest delay in counter ticks that can be used. */
+    uint32_t m_maxDelay_ticks = 0;
+
+    /**
+     * The longest delay in nanoseconds that fits in m_maxDelay_ticks. Checked before converting to ticks, which also
+     * stops the conversion overflowing.
+     */
+    uint64_t m_maxDelay_ns = 0;
+
+    std::function<void()> m_callback;
+};
+
+} // namespace zct
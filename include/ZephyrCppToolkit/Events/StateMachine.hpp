@@ -0,0 +1,512 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "EventThread.hpp"
+#include "Timer.hpp"
+
+//================================================================================================//
+// MACROS
+//================================================================================================//
+
+// Don't use constexpr here, it seg faults!
+// static constexpr int LOG_LEVEL = LOG_LEVEL_DBG;
+#define ZCT_STATE_MACHINE_LOG_LEVEL LOG_LEVEL_WRN
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief A hierarchical state machine (HSM) which runs in the context of a zct::EventThread.
+ *
+ * Inherit from this class (CRTP style) and provide a `static constexpr` state table named `STATES` in the derived
+ * class. Each entry describes one state: its ID, its parent (if any), the initial substate to drill into when the
+ * state is the target of a transition (if any), and pointers to the entry, exit and event handler member functions.
+ * Any of the member function pointers can be nullptr.
+ *
+ * The state table is `constexpr`, so it is placed in read-only memory (flash), and it is validated at compile time.
+ * The lowest common ancestor of every possible transition is also calculated at compile time (a table of N x N bytes
+ * for N states), so a transition only walks the states it exits and enters. Dispatching an event does not use any
+ * virtual calls.
+ *
+ * The state ID type must be an enum whose values are 0, 1, 2, ..., and the table must list the states in that order.
+ *
+ * Events received by the event thread are dispatched to the current state's event handler. If the handler returns false
+ * (or there is no handler) the event is passed to the parent state, and so on up to the top-level state. Call
+ * transitionTo() from an event handler to change state. The transition is carried out once the handler returns: exit
+ * handlers are called from the current state up to (but not including) the lowest common ancestor of the current and
+ * target states, and then entry handlers from there down to the target state. A transition to the current state
+ * (or one of its ancestors) exits and re-enters that state.
+ *
+ * Timers can be scoped to a state with scopeTimer(). Scoped timers are automatically stopped when their state is exited,
+ * so you don't have to remember to stop them on every transition out of the state. The scoped timer list is allocated
+ * in the constructor; inherit from StaticStateMachine instead to reserve it inside the object.
+ *
+ * Below is an example:
+ *
+ * \code
+ * enum class LedState : uint8_t { Off, On, Flashing };
+ *
+ * class Led : public zct::StateMachine<Led, Events::Generic, LedState> {
+ * public:
+ *     Led() :
+ *         StateMachine(m_eventThread, 1),
+ *         m_eventThread("Led", m_threadStack, THREAD_STACK_SIZE, 7, EVENT_QUEUE_NUM_ITEMS),
+ *         m_flashTimer("FlashTimer", [this]() { dispatch(Events::FlashTimerExpired()); }, m_eventThread.timerManager())
+ *     {
+ *         scopeTimer(m_flashTimer, LedState::Flashing);
+ *         start(LedState::Off);
+ *         m_eventThread.start();
+ *     }
+ *
+ *     void onOffEvent(const Events::Generic& event) { ... }
+ *     ...
+ *
+ *     static constexpr State STATES[] = {
+ *         { .id = LedState::Off, .parent = std::nullopt, .initial = std::nullopt, .entry = nullptr, .exit = nullptr, .handleEvent = &Led::onOffEvent },
+ *         { .id = LedState::On, ... },
+ *         { .id = LedState::Flashing, .parent = LedState::On, ... },
+ *     };
+ * };
+ * \endcode
+ *
+ * \tparam Derived The class inheriting from this state machine. Entry, exit and event handlers are member functions of this class.
+ * \tparam EventType The event type of the event thread the state machine runs in.
+ * \tparam StateId An enum identifying the states.
+ */
+template <typename Derived, typename EventType, typename StateId>
+class StateMachine {
+    static_assert(std::is_enum_v<StateId>, "StateId must be an enum.");
+
+public:
+
+    /** An entry in the state table. */
+    struct State {
+        StateId id;                                         ///< The ID of this state. Must match the position of this state in the table.
+        std::optional<StateId> parent;                      ///< The parent of this state, or std::nullopt for a top-level state.
+        std::optional<StateId> initial;                     ///< The substate to enter when this state is the target of a transition, or std::nullopt.
+        void (Derived::*entry)();                           ///< Called when the state is entered. Can be nullptr.
+        void (Derived::*exit)();                            ///< Called when the state is exited. Can be nullptr.
+        bool (Derived::*handleEvent)(const EventType&);     ///< Called with each event while in this state. Return true if the event was handled. Can be nullptr.
+    };
+
+    /**
+     * Create a new state machine.
+     *
+     * Dynamically allocates memory for the scoped timer list.
+     *
+     * The event thread does not have to be constructed yet (it can be a member of the derived class), it is not used until start() is called.
+     *
+     * \param eventThread The event thread the state machine runs in. External events received by this thread are dispatched to the state machine.
+     * \param maxNumScopedTimers The maximum number of timers that can be scoped to states with scopeTimer().
+     * \param arena The arena to allocate the scoped timer list from. If nullptr, the default arena is used, or the heap if there is none.
+     */
+    StateMachine(EventThread<EventType>& eventThread, uint32_t maxNumScopedTimers, Arena* arena = nullptr) :
+        m_eventThread(eventThread),
+        m_maxNumScopedTimers(maxNumScopedTimers),
+        m_arena(Arena::resolve(arena))
+    {
+        m_scopedTimers = Arena::newArray<ScopedTimer>(m_arena, maxNumScopedTimers);
+        __ASSERT_NO_MSG(m_scopedTimers != nullptr);
+    }
+
+    ~StateMachine() {
+        // Free the memory allocated in constructor.
+        if (m_isStorageOwned) {
+            Arena::deleteArray(m_arena, m_scopedTimers, m_maxNumScopedTimers);
+        }
+    }
+
+    // Prevent copying and moving, the event thread holds a pointer to this object
+    StateMachine(const StateMachine&) = delete;
+    StateMachine& operator=(const StateMachine&) = delete;
+
+    /**
+     * Enter the initial state and start receiving events from the event thread.
+     *
+     * Entry handlers are called for the initial state and all of its ancestors (top-level first), in the context of the
+     * calling thread. Call this before EventThread::start(), or from the event thread itself.
+     *
+     * \param initialState The state to start in. If it has an initial substate, that will be entered too.
+     */
+    void start(StateId initialState) {
+        LOG_MODULE_DECLARE(zct_StateMachine, ZCT_STATE_MACHINE_LOG_LEVEL);
+        static_assert(Tables<>::isValid(), "State table must be ordered by state ID, and initial substates must be children of their state.");
+        static_assert(Tables<>::hasNoLoops(), "State hierarchy must not contain loops.");
+        __ASSERT(!m_isStarted, "State machine has already been started.");
+        m_eventThread.onExternalEvent([this](const EventType& event) {
+            dispatch(event);
+        });
+        m_isStarted = true;
+        enterDownTo(std::nullopt, toIndex(initialState));
+    }
+
+    /**
+     * Dispatch an event to the state machine. This is called automatically for every external event received by the
+     * event thread, but can also be called directly from the event thread (e.g. from a timer callback).
+     *
+     * MUST BE CALLED FROM THE EVENT THREAD.
+     *
+     * \param event The event to dispatch.
+     */
+    void dispatch(const EventType& event) {
+        LOG_MODULE_DECLARE(zct_StateMachine, ZCT_STATE_MACHINE_LOG_LEVEL);
+        __ASSERT(m_isStarted, "dispatch() called before start().");
+        __ASSERT(!m_isDispatching, "dispatch() must not be called from inside a state handler.");
+        m_isDispatching = true;
+
+        // Give the event to the current state, then its ancestors, until one handles it
+        std::optional<uint8_t> stateIdx = m_currentIdx;
+        while (stateIdx.has_value()) {
+            const State& state = Tables<>::states[*stateIdx];
+            if (state.handleEvent != nullptr && (derived().*state.handleEvent)(event)) {
+                break;
+            }
+            stateIdx = parentOf(*stateIdx);
+        }
+        m_isDispatching = false;
+
+        if (m_pendingTransition.has_value()) {
+            uint8_t targetIdx = *m_pendingTransition;
+            m_pendingTransition.reset();
+            performTransition(targetIdx);
+        }
+    }
+
+    /**
+     * Request a transition to a new state. The transition is performed once the current event handler returns.
+     *
+     * MUST BE CALLED FROM AN EVENT HANDLER.
+     *
+     * \param targetState The state to transition to. If it has an initial substate, that will be entered too.
+     */
+    void transitionTo(StateId targetState) {
+        LOG_MODULE_DECLARE(zct_StateMachine, ZCT_STATE_MACHINE_LOG_LEVEL);
+        __ASSERT(m_isDispatching, "transitionTo() must be called from an event handler.");
+        __ASSERT(!m_pendingTransition.has_value(), "Only one transition can be requested per event.");
+        m_pendingTransition = toIndex(targetState);
+    }
+
+    /**
+     * Get the current (innermost) state.
+     *
+     * \return The current state.
+     */
+    StateId getCurrentState() const {
+        __ASSERT(m_isStarted, "getCurrentState() called before start().");
+        return Tables<>::states[*m_currentIdx].id;
+    }
+
+    /**
+     * Check if the state machine is in a state. This is true if the state is the current state or one of its ancestors.
+     *
+     * \param state The state to check.
+     * \return True if the state machine is in the state, false otherwise.
+     */
+    bool isInState(StateId state) const {
+        std::optional<uint8_t> stateIdx = m_currentIdx;
+        while (stateIdx.has_value()) {
+            if (*stateIdx == toIndex(state)) {
+                return true;
+            }
+            stateIdx = parentOf(*stateIdx);
+        }
+        return false;
+    }
+
+    /**
+     * Scope a timer to a state. The timer is automatically stopped when the state is exited.
+     *
+     * Typically called once at initialisation. The timer must exist for as long as the state machine does.
+     *
+     * \param timer The timer to scope.
+     * \param state The state the timer is scoped to.
+     */
+    void scopeTimer(Timer& timer, StateId state) {
+        __ASSERT(m_numScopedTimers < m_maxNumScopedTimers, "Max number of scoped timers of %u reached.", m_maxNumScopedTimers);
+        m_scopedTimers[m_numScopedTimers] = ScopedTimer{ &timer, toIndex(state) };
+        m_numScopedTimers++;
+    }
+
+protected:
+
+    /** A timer which is stopped when the state it is scoped to is exited. */
+    struct ScopedTimer {
+        Timer* timer = nullptr;
+        uint8_t stateIdx = 0;
+    };
+
+    /**
+     * Create a new state machine which stores the scoped timer list in memory owned by the caller. Used by
+     * StaticStateMachine.
+     *
+     * \param eventThread The event thread the state machine runs in.
+     * \param scopedTimers Space for maxNumScopedTimers scoped timers. Must outlive the state machine.
+     * \param maxNumScopedTimers The maximum number of timers that can be scoped to states with scopeTimer().
+     */
+    StateMachine(EventThread<EventType>& eventThread, ScopedTimer* scopedTimers, uint32_t maxNumScopedTimers) :
+        m_eventThread(eventThread),
+        m_scopedTimers(scopedTimers),
+        m_maxNumScopedTimers(maxNumScopedTimers),
+        m_arena(nullptr),
+        m_isStorageOwned(false)
+    {
+    }
+
+    /**
+     * Compile time information generated from the derived class's state table. This is a template so that it is only
+     * instantiated once the derived class is complete.
+     */
+    template <typename D = Derived>
+    struct Tables {
+        static constexpr const auto& states = D::STATES;
+        static constexpr size_t numStates = std::size(D::STATES);
+
+        static_assert(numStates > 0, "State table must contain at least one state.");
+        static_assert(numStates < UINT8_MAX, "Too many states.");
+
+        /** Used in the LCA table when two states have no common ancestor. */
+        static constexpr uint8_t NO_STATE = UINT8_MAX;
+
+        /** Check that the table is ordered by ID and that every parent and initial substate is valid. */
+        static constexpr bool isValid() {
+            for (size_t i = 0; i < numStates; i++) {
+                if (static_cast<size_t>(states[i].id) != i) {
+                    return false;
+                }
+                if (states[i].parent.has_value() && static_cast<size_t>(*states[i].parent) >= numStates) {
+                    return false;
+                }
+                if (states[i].initial.has_value()) {
+                    size_t initialIdx = static_cast<size_t>(*states[i].initial);
+                    if (initialIdx >= numStates || !states[initialIdx].parent.has_value() || *states[initialIdx].parent != states[i].id) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /** Calculate the depth of each state. Top-level states have a depth of 0. */
+        static constexpr std::array<uint8_t, numStates> calcDepths() {
+            std::array<uint8_t, numStates> result{};
+            for (size_t i = 0; i < numStates; i++) {
+                size_t depth = 0;
+                std::optional<StateId> parent = states[i].parent;
+                while (parent.has_value()) {
+                    depth++;
+                    if (depth >= numStates) {
+                        // Only possible if there is a loop in the hierarchy
+                        return {};
+                    }
+                    parent = states[static_cast<size_t>(*parent)].parent;
+                }
+                result[i] = static_cast<uint8_t>(depth);
+            }
+            return result;
+        }
+
+        static constexpr std::array<uint8_t, numStates> depths = calcDepths();
+
+        /** Check for loops in the hierarchy. calcDepths() returns all zeros if it finds one. */
+        static constexpr bool hasNoLoops() {
+            for (size_t i = 0; i < numStates; i++) {
+                if (states[i].parent.has_value() && depths[i] == 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static constexpr uint8_t parentIdx(uint8_t stateIdx) {
+            return states[stateIdx].parent.has_value() ? static_cast<uint8_t>(*states[stateIdx].parent) : NO_STATE;
+        }
+
+        /** Check if a state is the same as or a descendant of an ancestor. Gives up after numStates steps in case of a loop. */
+        static constexpr bool isAncestorOrSelf(uint8_t ancestorIdx, uint8_t stateIdx) {
+            for (size_t steps = 0; stateIdx != NO_STATE && steps < numStates; steps++) {
+                if (stateIdx == ancestorIdx) {
+                    return true;
+                }
+                stateIdx = parentIdx(stateIdx);
+            }
+            return false;
+        }
+
+        /**
+         * Calculate the lowest common ancestor for a transition from every source state to every target state. If the
+         * target is the source or one of its ancestors, the target's parent is used instead so that the target is exited
+         * and re-entered. NO_STATE means the transition exits and enters all the way from the top level.
+         */
+        static constexpr std::array<std::array<uint8_t, numStates>, numStates> calcLcas() {
+            std::array<std::array<uint8_t, numStates>, numStates> result{};
+            for (size_t source = 0; source < numStates; source++) {
+                for (size_t target = 0; target < numStates; target++) {
+                    uint8_t targetIdx = static_cast<uint8_t>(target);
+                    if (isAncestorOrSelf(targetIdx, static_cast<uint8_t>(source))) {
+                        targetIdx = parentIdx(targetIdx);
+                    }
+                    uint8_t lca = static_cast<uint8_t>(source);
+                    for (size_t steps = 0; lca != NO_STATE && steps < numStates && !isAncestorOrSelf(lca, targetIdx); steps++) {
+                        lca = parentIdx(lca);
+                    }
+                    result[source][target] = lca;
+                }
+            }
+            return result;
+        }
+
+        /** The lowest common ancestor of each transition, indexed by [source][target]. */
+        static constexpr std::array<std::array<uint8_t, numStates>, numStates> lcas = calcLcas();
+    };
+
+    Derived& derived() {
+        return *static_cast<Derived*>(this);
+    }
+
+    static constexpr uint8_t toIndex(StateId state) {
+        return static_cast<uint8_t>(state);
+    }
+
+    static std::optional<uint8_t> parentOf(uint8_t stateIdx) {
+        const auto& parent = Tables<>::states[stateIdx].parent;
+        if (!parent.has_value()) {
+            return std::nullopt;
+        }
+        return toIndex(*parent);
+    }
+
+    /**
+     * Exit from the current state up to (but not including) the lowest common ancestor of the current and target states,
+     * then enter down to the target state.
+     *
+     * \param targetIdx The index of the target state.
+     */
+    void performTransition(uint8_t targetIdx) {
+        LOG_MODULE_DECLARE(zct_StateMachine, ZCT_STATE_MACHINE_LOG_LEVEL);
+        LOG_DBG("Transitioning from state %u to state %u.", *m_currentIdx, targetIdx);
+
+        // The lowest common ancestor of every transition is calculated at compile time
+        std::optional<uint8_t> lca;
+        uint8_t lcaIdx = Tables<>::lcas[*m_currentIdx][targetIdx];
+        if (lcaIdx != Tables<>::NO_STATE) {
+            lca = lcaIdx;
+        }
+
+        // Exit up to the lowest common ancestor
+        while (m_currentIdx != lca) {
+            exitState(*m_currentIdx);
+            m_currentIdx = parentOf(*m_currentIdx);
+        }
+
+        enterDownTo(lca, targetIdx);
+    }
+
+    /**
+     * Enter all states from just below an ancestor down to the target state, then follow any initial substates.
+     *
+     * \param ancestorIdx The state to enter from (not entered itself). std::nullopt to enter from the top level.
+     * \param targetIdx The state to enter.
+     */
+    void enterDownTo(std::optional<uint8_t> ancestorIdx, uint8_t targetIdx) {
+        // Build the path from the target up to the ancestor, then enter it in reverse order
+        std::array<uint8_t, Tables<>::numStates> path;
+        size_t pathLength = 0;
+        for (std::optional<uint8_t> stateIdx = targetIdx; stateIdx != ancestorIdx; stateIdx = parentOf(*stateIdx)) {
+            path[pathLength++] = *stateIdx;
+        }
+        while (pathLength > 0) {
+            enterState(path[--pathLength]);
+        }
+
+        // Drill down into initial substates
+        while (Tables<>::states[*m_currentIdx].initial.has_value()) {
+            enterState(toIndex(*Tables<>::states[*m_currentIdx].initial));
+        }
+    }
+
+    void enterState(uint8_t stateIdx) {
+        m_currentIdx = stateIdx;
+        const State& state = Tables<>::states[stateIdx];
+        if (state.entry != nullptr) {
+            (derived().*state.entry)();
+        }
+    }
+
+    void exitState(uint8_t stateIdx) {
+        const State& state = Tables<>::states[stateIdx];
+        if (state.exit != nullptr) {
+            (derived().*state.exit)();
+        }
+        // Stop any timers scoped to this state
+        for (uint32_t i = 0; i < m_numScopedTimers; i++) {
+            if (m_scopedTimers[i].stateIdx == stateIdx) {
+                m_scopedTimers[i].timer->stop();
+            }
+        }
+    }
+
+    EventThread<EventType>& m_eventThread;
+
+    /** The index of the current (innermost) state. Only std::nullopt before start() is called or while transitioning. */
+    std::optional<uint8_t> m_currentIdx;
+
+    /** Set by transitionTo(), performed at the end of dispatch(). */
+    std::optional<uint8_t> m_pendingTransition;
+
+    bool m_isStarted = false;
+    bool m_isDispatching = false;
+
+    ScopedTimer* m_scopedTimers = nullptr;
+    uint32_t m_numScopedTimers = 0;
+    uint32_t m_maxNumScopedTimers;
+
+    /** Where m_scopedTimers was allocated from, nullptr for the heap. */
+    Arena* m_arena;
+
+    /** False if m_scopedTimers is owned by a derived class, in which case it is not freed. */
+    bool m_isStorageOwned = true;
+};
+
+/**
+ * A StateMachine with space for MaxNumScopedTimers scoped timers reserved inside the object, so no memory is allocated.
+ * Inherit from this instead of StateMachine, in the same way.
+ *
+ * \tparam Derived The class inheriting from this state machine.
+ * \tparam EventType The event type of the event thread the state machine runs in.
+ * \tparam StateId An enum identifying the states.
+ * \tparam MaxNumScopedTimers The maximum number of timers that can be scoped to states with scopeTimer().
+ */
+template <typename Derived, typename EventType, typename StateId, uint32_t MaxNumScopedTimers>
+class StaticStateMachine : public StateMachine<Derived, EventType, StateId> {
+public:
+
+    /**
+     * Create a new state machine.
+     *
+     * \param eventThread The event thread the state machine runs in. It does not have to be constructed yet.
+     */
+    StaticStateMachine(EventThread<EventType>& eventThread) :
+        StateMachine<Derived, EventType, StateId>(eventThread, m_storage, MaxNumScopedTimers)
+    {
+    }
+
+protected:
+    typename StateMachine<Derived, EventType, StateId>::ScopedTimer m_storage[MaxNumScopedTimers];
+};
+
+} // namespace zct
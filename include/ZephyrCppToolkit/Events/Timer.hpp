@@ -4,6 +4,7 @@
 // INCLUDES
 //================================================================================================//
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <functional>
@@ -11,6 +12,9 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+#include "TimerManager.hpp"
+
 //================================================================================================//
 // MACROS
 //================================================================================================//
@@ -21,9 +25,6 @@
 
 namespace zct {
 
-// Forward declarations
-class TimerManager;
-
 //================================================================================================//
 // CLASS DECLARATION
 //================================================================================================//
@@ -40,6 +41,47 @@ class TimerManager;
 class Timer {
 public:
 
+    /**
+     * Lateness statistics for a timer, see setStatsEnabled().
+     * 
+     * Lateness is the time from when the timer was due to expire to when the expiry was handled (i.e. just before the
+     * expiry callback is called). All times are in ticks, as that is the resolution the lateness is measured at.
+     */
+    struct Stats {
+        /** The number of buckets in the lateness histogram. */
+        static constexpr uint32_t NUM_HISTOGRAM_BUCKETS = 8;
+
+        /** The number of expiries handled since the stats were enabled or reset. */
+        uint32_t numExpiries = 0;
+
+        /**
+         * The number of expiries which were handled so late that the next expiry of the (recurring) timer was already due.
+         * These expiries are handled back-to-back in a catch-up burst.
+         */
+        uint32_t numCatchUpExpiries = 0;
+
+        int64_t minLateness_ticks = INT64_MAX;
+        int64_t maxLateness_ticks = 0;
+
+        /** The sum of the lateness of all expiries, used to calculate the mean. */
+        int64_t totalLateness_ticks = 0;
+
+        /**
+         * Log-scale histogram of the lateness. Bucket 0 counts expiries handled on the tick they were due, and bucket n counts
+         * expiries which were [2^(n-1), 2^n) ticks late. The last bucket also counts anything later than that.
+         */
+        uint32_t latenessHistogram[NUM_HISTOGRAM_BUCKETS] = {};
+
+        /**
+         * Get the mean lateness.
+         * 
+         * @return The mean lateness in ticks, or 0 if there have been no expiries.
+         */
+        int64_t getMeanLateness_ticks() const {
+            return numExpiries == 0 ? 0 : totalLateness_ticks / numExpiries;
+        }
+    };
+
     /**
      * Create a new timer with a callback function.
      * 
@@ -65,6 +107,15 @@ public:
      */
     Timer(const char* name, std::function<void()> expiryCallback, TimerManager& timerManager);
 
+    /**
+     * Destroy the timer, unregistering it from its timer manager if it is registered with one.
+     */
+    ~Timer();
+
+    // Prevent copying, the timer manager holds a pointer to this object
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
     /**
      * Start the timer in reoccurring mode. The timer will expire for the first time
      * after period_ms from when this is called, and then period_ms after that.
@@ -76,11 +127,119 @@ public:
     /**
      * Start the timer in either one-shot or reoccurring mode.
      * 
+     * The first expiry is rounded up to the next tick. If the period is not a whole number of ticks, the fraction of a tick is
+     * accumulated across expiries so that the timer does not drift (e.g. a 1ms period with a 32768Hz tick expires
+     * alternately after 32 and 33 ticks, averaging exactly 1ms).
+     * 
      * @param startDuration_ms The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
      * @param period_ms The period of the timer. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
     */
     void start(int64_t startDuration_ms, int64_t period_ms);
 
+    /**
+     * Start the timer with Zephyr timeouts, e.g. `K_USEC(500)`, `K_TICKS(3)`.
+     * 
+     * Note that Zephyr timeouts are always a whole number of ticks. Use the std::chrono overload if you need periods which
+     * are not a whole number of ticks.
+     * 
+     * @param startDuration The time to wait before the first expiry. Must be a relative timeout. K_NO_WAIT expires straight away.
+     * @param period The period of the timer. Set to K_FOREVER for a one-shot timer.
+    */
+    void start(k_timeout_t startDuration, k_timeout_t period);
+
+    /**
+     * Start the timer with durations in ticks.
+     * 
+     * @param startDuration_ticks The number of ticks to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period_ticks The period of the timer in ticks. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
+    */
+    void startTicks(int64_t startDuration_ticks, int64_t period_ticks);
+
+    /**
+     * Start the timer in reoccurring mode with a std::chrono duration, e.g. `std::chrono::microseconds(250)`.
+     * 
+     * @param period The period of the timer. Should be positive.
+    */
+    template <typename Rep, typename Period>
+    void start(std::chrono::duration<Rep, Period> period) {
+        start(period, period);
+    }
+
+    /**
+     * Start the timer in either one-shot or reoccurring mode with std::chrono durations.
+     * 
+     * Durations are kept to nanosecond resolution. As with the millisecond version, the first expiry is rounded up to
+     * the next tick and fractional periods are accumulated without drift.
+     * 
+     * @param startDuration The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period The period of the timer. Set to a negative duration for a one-shot timer, or 0/positive for a recurring timer.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    void start(std::chrono::duration<Rep1, Period1> startDuration, std::chrono::duration<Rep2, Period2> period) {
+        int64_t period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(period).count();
+        startNs(k_uptime_ticks(), std::chrono::duration_cast<std::chrono::nanoseconds>(startDuration).count(), period_ns < 0 ? -1 : period_ns);
+    }
+
+    /**
+     * Start the timer with an absolute first expiry time, rather than a duration from now.
+     * 
+     * If the expiry time is in the past, the timer expires straight away. A recurring timer will then expire once for each
+     * period that has been missed, keeping its expiries anchored to the given expiry time.
+     * 
+     * @param expiryTime_ticks The uptime in ticks to expire at for the first time, e.g. from k_uptime_ticks().
+     * @param period_ticks The period of the timer in ticks. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
+    */
+    void startAtTicks(int64_t expiryTime_ticks, int64_t period_ticks);
+
+    /**
+     * Start the timer with an absolute first expiry time as a std::chrono duration since boot. See startAtTicks().
+     * 
+     * @param expiryTime The uptime to expire at for the first time. Must be 0 or positive.
+     * @param period The period of the timer. Set to a negative duration for a one-shot timer, or 0/positive for a recurring timer.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    void startAt(std::chrono::duration<Rep1, Period1> expiryTime, std::chrono::duration<Rep2, Period2> period) {
+        int64_t period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(period).count();
+        startAtNs(std::chrono::duration_cast<std::chrono::nanoseconds>(expiryTime).count(), period_ns < 0 ? -1 : period_ns);
+    }
+
+    /**
+     * Start the timer in reoccurring mode, with expiries aligned to multiples of the period since boot (plus an optional phase).
+     * 
+     * For example, `startAligned(100)` expires at uptimes of 100ms, 200ms, 300ms, ... no matter when it is called, and
+     * `startAligned(100, 10)` expires at 110ms, 210ms, 310ms, ... Timers started this way with the same period expire
+     * in the same event loop wakeup, and their expiries do not drift relative to each other.
+     * 
+     * The first expiry is the next aligned time which is not in the past. If now is exactly an aligned time, the timer expires straight away.
+     * 
+     * @param period_ms The period of the timer. Must be positive.
+     * @param phase_ms The offset of the expiries from multiples of the period. Must be 0 or positive.
+    */
+    void startAligned(int64_t period_ms, int64_t phase_ms = 0);
+
+    /**
+     * Start the timer in reoccurring mode, with expiries aligned to multiples of the period since boot. See startAligned(int64_t, int64_t).
+     * 
+     * @param period The period of the timer. Must be positive.
+    */
+    template <typename Rep, typename Period>
+    void startAligned(std::chrono::duration<Rep, Period> period) {
+        startAlignedNs(std::chrono::duration_cast<std::chrono::nanoseconds>(period).count(), 0);
+    }
+
+    /**
+     * Start the timer in reoccurring mode, with expiries aligned to multiples of the period since boot plus a phase.
+     * See startAligned(int64_t, int64_t).
+     * 
+     * @param period The period of the timer. Must be positive.
+     * @param phase The offset of the expiries from multiples of the period. Must be 0 or positive.
+    */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    void startAligned(std::chrono::duration<Rep1, Period1> period, std::chrono::duration<Rep2, Period2> phase) {
+        startAlignedNs(std::chrono::duration_cast<std::chrono::nanoseconds>(period).count(),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(phase).count());
+    }
+
     /**
      * Stop the timer. This will prevent the timer from expiring until
      * start() is called again.
@@ -90,6 +249,49 @@ public:
      */
     void stop();
 
+    /**
+     * Start the timer from any thread or ISR.
+     * 
+     * start() and stop() must only be called from the event thread that owns the timer manager this timer is registered with,
+     * as they modify the timer manager's state. This function can be called from anywhere. It posts a start command to the
+     * timer manager and wakes the owning event thread, which applies the command before it next looks at its timers.
+     * 
+     * The start duration is measured from when this function is called, not from when the command is applied, so a short
+     * timer started while the event thread is blocked waiting on a long timeout still expires on time.
+     * 
+     * If another start or stop command is posted before this one is applied, only the latest one takes effect.
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     * 
+     * @param startDuration_ms The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period_ms The period of the timer. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
+     */
+    void startAsync(int64_t startDuration_ms, int64_t period_ms);
+
+    /**
+     * Start the timer from any thread or ISR with std::chrono durations. See startAsync(int64_t, int64_t).
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     * 
+     * @param startDuration The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period The period of the timer. Set to a negative duration for a one-shot timer, or 0/positive for a recurring timer.
+     */
+    template <typename Rep1, typename Period1, typename Rep2, typename Period2>
+    void startAsync(std::chrono::duration<Rep1, Period1> startDuration, std::chrono::duration<Rep2, Period2> period) {
+        int64_t period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(period).count();
+        postCommand(Command::Start, std::chrono::duration_cast<std::chrono::nanoseconds>(startDuration).count(), period_ns < 0 ? -1 : period_ns);
+    }
+
+    /**
+     * Stop the timer from any thread or ISR. See startAsync().
+     * 
+     * A timer callback which is already due may still be called once if the event thread is handling expired timers
+     * when this is called.
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     */
+    void stopAsync();
+
     /**
      * Check if the timer is running.
      * 
@@ -115,20 +317,39 @@ public:
     int64_t getNextExpiryTimeTicks() const;
 
     /**
-     * Set the isRegistered flag. Used to log warnings if a timer is
-     * started when it is not registered with any timer managers.
+     * Get the exact next expiry time of the timer, including any fraction of a tick which is rounded up
+     * in getNextExpiryTimeTicks().
      * 
-     * @param isRegistered The value to set the isRegistered flag to.
+     * @return The next expiry time of the timer in nanoseconds since boot, or INT64_MAX if the timer is not running.
      */
-    void setIsRegistered(bool isRegistered);
+    int64_t getNextExpiryTimeNs() const;
 
     /**
-     * Get the isRegistered flag.
+     * Check if the timer is registered with a timer manager.
      * 
-     * @return The value of the isRegistered flag.
+     * @return True if the timer is registered with a timer manager.
      */
     bool getIsRegistered() const;
 
+    /**
+     * Set the timer manager this timer is registered with. Called by TimerManager::registerTimer().
+     * 
+     * From then on the timer's expiry time and period are stored in the timer manager's slot for this timer, and the timer
+     * manager is notified whenever the timer is started, stopped or updated after expiry.
+     * 
+     * @param timerManager The timer manager this timer is registered with.
+     * @param slot The slot in the timer manager allocated to this timer.
+     */
+    void setTimerManager(TimerManager* timerManager, uint32_t slot);
+
+    /**
+     * Detach the timer from its timer manager. Called by TimerManager::unregisterTimer() and when the timer manager is
+     * destroyed.
+     * 
+     * The timer's expiry time and period are moved back into the timer, so it can be registered again later.
+     */
+    void clearTimerManager();
+
     /**
      * Set the expiry callback function.
      * 
@@ -143,14 +364,203 @@ public:
      */
     const std::function<void()>& getExpiryCallback() const;
 
+    /**
+     * Enable or disable recording of lateness statistics for this timer. Disabled by default.
+     * 
+     * When enabled, every expiry handled with updateAfterExpiry() reads the uptime once and updates the statistics.
+     * Enabling the stats does not reset them, use resetStats() for that.
+     * 
+     * @param isEnabled True to record statistics.
+     */
+    void setStatsEnabled(bool isEnabled);
+
+    /**
+     * Check if lateness statistics are being recorded for this timer.
+     * 
+     * @return True if statistics are being recorded.
+     */
+    bool getStatsEnabled() const;
+
+    /**
+     * Get the lateness statistics of this timer. See setStatsEnabled().
+     * 
+     * @return The statistics recorded since they were last reset.
+     */
+    const Stats& getStats() const;
+
+    /**
+     * Reset the lateness statistics of this timer.
+     */
+    void resetStats();
+
+    /**
+     * Get the name of the timer.
+     * 
+     * @return The name of the timer, as provided in the constructor.
+     */
+    const char* getName() const;
+
 protected:
-    int64_t period_ticks = 0;
+
+    // TimerManager reads the slot of the timer
+    friend class TimerManager;
+
+    // TimerGroup changes timers in bulk and then notifies the timer manager once
+    friend class TimerGroup;
+
+    // EventThread reads the event of event timers
+    template <typename EventType>
+    friend class EventThread;
+
+    /**
+     * Fractions of a tick are stored as a numerator over this denominator. A nanosecond based denominator means any duration
+     * in nanoseconds can be converted to ticks exactly.
+     */
+    static constexpr uint32_t TICK_FRACTION_DENOMINATOR = 1000000000U;
+
+    /**
+     * Start the timer with durations in nanoseconds. All the start() functions end up here.
+     * 
+     * @param startTime_ticks The time the durations are measured from, normally now.
+     * @param startDuration_ns The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period_ns The period of the timer. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
+     */
+    void startNs(int64_t startTime_ticks, int64_t startDuration_ns, int64_t period_ns);
+
+    /**
+     * Start the timer with an absolute first expiry time in nanoseconds since boot.
+     * 
+     * @param expiryTime_ns The uptime to expire at for the first time. Must be 0 or positive.
+     * @param period_ns The period of the timer. Set to -1 for a one-shot timer, or 0/positive for a recurring timer.
+     */
+    void startAtNs(int64_t expiryTime_ns, int64_t period_ns);
+
+    /**
+     * Start the timer with expiries at phase_ns + n * period_ns since boot.
+     * 
+     * @param period_ns The period of the timer. Must be positive.
+     * @param phase_ns The offset of the expiries from multiples of the period. Must be 0 or positive.
+     */
+    void startAlignedNs(int64_t period_ns, int64_t phase_ns);
+
+    /**
+     * Start the timer with exact durations in ticks.
+     * 
+     * @param startTime_ticks The time the durations are measured from, normally now.
+     * @param startDuration_ticks Whole number of ticks to wait before the first expiry.
+     * @param startDurationFraction Additional fraction of a tick to wait before the first expiry, over TICK_FRACTION_DENOMINATOR.
+     * @param period_ticks Whole number of ticks in the period, or -1 for a one-shot timer.
+     * @param periodFraction Additional fraction of a tick in the period, over TICK_FRACTION_DENOMINATOR.
+     */
+    void startExact(int64_t startTime_ticks, int64_t startDuration_ticks, uint32_t startDurationFraction, int64_t period_ticks, uint32_t periodFraction);
+
+    /**
+     * Same as startExact(), but without notifying the timer manager. The caller must notify the timer manager.
+     */
+    void applyStart(int64_t startTime_ticks, int64_t startDuration_ticks, uint32_t startDurationFraction, int64_t period_ticks, uint32_t periodFraction);
+
+    /**
+     * Same as stop(), but without notifying the timer manager. The caller must notify the timer manager.
+     */
+    void applyStop();
+
+    /**
+     * Convert a duration in nanoseconds into ticks without rounding.
+     * 
+     * @param duration_ns The duration to convert. Must be 0 or positive.
+     * @param ticks Set to the whole number of ticks.
+     * @param fraction Set to the remaining fraction of a tick, over TICK_FRACTION_DENOMINATOR.
+     */
+    static void nsToTicks(int64_t duration_ns, int64_t& ticks, uint32_t& fraction);
+
+    /**
+     * Update the lateness statistics for an expiry.
+     * 
+     * @param expiryTime_ticks The time the timer was due to expire.
+     * @param now_ticks The time the expiry was handled.
+     */
+    void recordExpiryStats(int64_t expiryTime_ticks, int64_t now_ticks);
+
+    /**
+     * Tell the timer manager (if registered) that this timer has changed.
+     */
+    void notifyTimerManager();
+
+    /** Commands which can be posted to the timer from other threads and ISRs. See startAsync() and stopAsync(). */
+    enum class Command : uint8_t {
+        None,
+        Start,
+        Stop,
+    };
+
+    /**
+     * Save a command to be applied in the owning event thread, and tell the timer manager there is a command pending.
+     * If the timer is not registered with a timer manager, the command is applied straight away.
+     * 
+     * @param command The command to post.
+     * @param startDuration_ns Used by Command::Start, see startNs().
+     * @param period_ns Used by Command::Start, see startNs().
+     */
+    void postCommand(Command command, int64_t startDuration_ns, int64_t period_ns);
+
+    /**
+     * Apply the last command posted with postCommand(), if there is one. Called by the timer manager in the owning event thread.
+     */
+    void applyPendingCommand();
+
+    /**
+     * Get a reference to where the next expiry time of this timer is stored. This is in the timer manager once registered.
+     * 
+     * @return The next expiry time in ticks, or TimerManager::NOT_RUNNING_TICKS if the timer is not running.
+     */
+    int64_t& nextExpiryTimeTicks();
+    const int64_t& nextExpiryTimeTicks() const;
+
+    /**
+     * Get a reference to where the period of this timer is stored. This is in the timer manager once registered.
+     * 
+     * @return The period in ticks, or -1 for a one-shot timer.
+     */
+    int64_t& periodTicks();
+
     int64_t startTime_ticks = 0;
-    int64_t nextExpiryTime_ticks = 0;
-    bool m_isRunning = false;
-    bool m_isRegistered = false;
+
+    /** The fraction of a tick in the period which is not included in the period in ticks, over TICK_FRACTION_DENOMINATOR. */
+    uint32_t m_periodFraction = 0;
+
+    /**
+     * The fraction of a tick by which the exact expiry time is after the previous whole tick, over TICK_FRACTION_DENOMINATOR.
+     * If this is non-zero, the next expiry time has been rounded up to the next whole tick.
+     */
+    uint32_t m_expiryFraction = 0;
+
+    TimerManager* m_timerManager = nullptr;
+
+    /** The slot in the timer manager's arrays which holds this timer's expiry time and period. */
+    uint32_t m_slot = 0;
+
+    /** Where the expiry time and period are stored until the timer is registered with a timer manager. */
+    int64_t m_unregisteredNextExpiryTime_ticks = TimerManager::NOT_RUNNING_TICKS;
+    int64_t m_unregisteredPeriod_ticks = -1;
+
+    bool m_isStatsEnabled = false;
+    Stats m_stats;
+
+    /** Protects the pending command below, which is written from other threads and ISRs. */
+    SpinLock m_pendingCommandLock;
+    Command m_pendingCommand = Command::None;
+    int64_t m_pendingCommandTime_ticks = 0;
+    int64_t m_pendingStartDuration_ns = 0;
+    int64_t m_pendingPeriod_ns = -1;
+
     const char* m_name;
     std::function<void()> m_expiryCallback;
+
+    /**
+     * Points to the event stored in a zct::EventTimer, which is passed to the event thread's external event handler
+     * instead of calling the expiry callback. nullptr for plain timers.
+     */
+    const void* m_timerEvent = nullptr;
 };
 
 } // namespace zct
\ No newline at end of file
@@ -0,0 +1,143 @@
+#pragma once
+
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Core/Arena.hpp"
+#include "Timer.hpp"
+#include "TimerManager.hpp"
+
+namespace zct {
+
+//================================================================================================//
+// CLASS DECLARATION
+//================================================================================================//
+
+/**
+ * \brief A set of timers which can be started, stopped or rescheduled together.
+ * 
+ * Every timer in the group is changed first, and then the timer manager is told about all the changes in one go,
+ * rather than once per timer. All timers started together share the same start time, so their expiries stay
+ * in step with each other.
+ * 
+ * All timers in a group must be registered with the same timer manager, and the group must only be used from the
+ * event thread which owns that timer manager.
+ * 
+ * Typical use is stopping all of the timers related to a state when it is exited:
+ * 
+ * \code
+ * m_stateTimers.add(m_timeoutTimer);
+ * m_stateTimers.add(m_retryTimer);
+ * ...
+ * m_stateTimers.stopAll();
+ * \endcode
+ * 
+ * Dynamically allocates memory for the timer pointers in the constructor, from an Arena if one is given or set as the default.
+ * Use StaticTimerGroup to size the group at compile time instead.
+ */
+class TimerGroup {
+public:
+
+    /**
+     * Create a new, empty timer group.
+     * 
+     * @param maxNumTimers The maximum number of timers that can be added to the group.
+     * @param arena The arena to allocate from. If nullptr, the default arena is used, or the heap if there is none.
+     */
+    TimerGroup(uint32_t maxNumTimers, Arena* arena = nullptr);
+
+    ~TimerGroup();
+
+    /**
+     * Add a timer to the group. The timer must already be registered with a timer manager, and must exist for as
+     * long as the group does.
+     * 
+     * @param timer The timer to add.
+     */
+    void add(Timer& timer);
+
+    /**
+     * Start every timer in the group, with the same start time. See Timer::start(int64_t, int64_t).
+     * 
+     * @param startDuration_ms The time to wait before the first expiry. Must either be 0 (no-wait) or positive.
+     * @param period_ms The period of the timers. Set to -1 for one-shot timers, or 0/positive for recurring timers.
+     */
+    void startAll(int64_t startDuration_ms, int64_t period_ms);
+
+    /**
+     * Stop every timer in the group.
+     */
+    void stopAll();
+
+    /**
+     * Move the next expiry of every running timer in the group by the same amount. Periods are unchanged, so later
+     * expiries are moved too. Timers which are not running are left alone.
+     * 
+     * The shift is rounded towards later by up to a tick, so that timers never expire early.
+     * 
+     * @param delta_ms How far to move the expiries. Positive to delay them, negative to bring them forwards.
+     */
+    void shiftAll(int64_t delta_ms);
+
+    /**
+     * Get the number of timers in the group.
+     * 
+     * @return The number of timers added with add().
+     */
+    uint32_t getNumTimers() const;
+
+protected:
+
+    /**
+     * Create a new, empty timer group which stores the timer pointers in memory owned by the caller. Used by
+     * StaticTimerGroup.
+     * 
+     * @param timers Space for maxNumTimers timer pointers. Must outlive the group.
+     * @param maxNumTimers The maximum number of timers that can be added to the group.
+     */
+    TimerGroup(Timer** timers, uint32_t maxNumTimers);
+
+    /** Tell the timer manager about changes to every timer in the group. */
+    void notifyTimerManager();
+
+    Timer** m_timers;
+    uint32_t m_numTimers = 0;
+    uint32_t m_maxNumTimers;
+
+    /** Where m_timers was allocated from, nullptr for the heap. */
+    Arena* m_arena;
+
+    /** False if m_timers is owned by a derived class, in which case it is not freed. */
+    bool m_isStorageOwned = true;
+
+    /** The timer manager that all the timers are registered with. Set when the first timer is added. */
+    TimerManager* m_timerManager = nullptr;
+};
+
+/**
+ * A TimerGroup with space for MaxNumTimers timers reserved inside the object, so no memory is allocated.
+ * 
+ * \tparam MaxNumTimers The maximum number of timers that can be added to the group.
+ */
+template<uint32_t MaxNumTimers>
+class StaticTimerGroup : public TimerGroup {
+public:
+
+    /**
+     * Create a new, empty timer group.
+     */
+    StaticTimerGroup() :
+        TimerGroup(m_storage, MaxNumTimers)
+    {
+    }
+
+protected:
+    Timer* m_storage[MaxNumTimers];
+};
+
+} // namespace zct
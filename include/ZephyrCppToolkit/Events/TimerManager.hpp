@@ -5,10 +5,15 @@
 //================================================================================================//
 
 // System includes
+#include <functional>
 #include <stdint.h>
 
 // 3rd party includes
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+// 1st party includes
+#include "ZephyrCppToolkit/Core/Arena.hpp"
 
 //================================================================================================//
 // MACROS
@@ -27,18 +32,33 @@ namespace zct {
 // Forward declarations
 class Timer;
 
+/**
+ * \brief Keeps track of a number of timers and works out which one expires next.
+ * 
+ * The fields needed to find the next expiring timer (the expiry time and period of each timer) are stored by the
+ * timer manager in contiguous arrays indexed by the timer's slot, rather than in each zct::Timer object. Scanning
+ * the timers is then a simple min-reduction over an array of `int64_t`, which stays in cache and can be vectorised
+ * by the compiler, rather than chasing a pointer to each timer object.
+ */
 class TimerManager {
 public:
 
+    /**
+     * The expiry time stored for timers which are not running. This is larger than any real expiry time, so that
+     * stopped timers never win the search for the next expiring timer.
+     */
+    static constexpr int64_t NOT_RUNNING_TICKS = INT64_MAX;
+
     /**
      * Create a new timer manager.
      * 
-     * Dynamically allocates memory for maxNumTimers pointers to timers.
+     * Dynamically allocates memory for maxNumTimers pointers to timers, plus the expiry time and period of each timer.
      * 
      * @param maxNumTimers The maximum number of timers that can be registered with the timer manager. Space for
-     *                     this many pointers to timers will be allocated on the heap.
+     *                     this many timers will be allocated from the arena.
+     * @param arena The arena to allocate from. If nullptr, the default arena is used, or the heap if there is none.
      */
-    TimerManager(uint32_t maxNumTimers);
+    TimerManager(uint32_t maxNumTimers, Arena* arena = nullptr);
 
     ~TimerManager();
 
@@ -58,6 +78,16 @@ public:
      */
     void registerTimer(Timer& timer);
 
+    /**
+     * Unregisters a timer from the timer manager, freeing its slot for another timer. Timers unregister themselves
+     * when they are destroyed.
+     * 
+     * The timer keeps its expiry time and period, but will not expire until it is registered again.
+     * 
+     * @param timer The timer to unregister. Must be registered with this timer manager.
+     */
+    void unregisterTimer(Timer& timer);
+
     /**
      * Iterates over all registered timers and returns the expiry time of the timer that expires next.
      * If no timer is found, the 'timer' member of the returned struct will be nullptr. timer is guaranteed to
@@ -69,11 +99,160 @@ public:
      */
     TimerExpiryInfo getNextExpiringTimer();
 
+    /**
+     * Enable or disable sub-tick precision.
+     * 
+     * By default, a timer is only treated as expired once the system tick it expires on has been reached, and
+     * getNextExpiringTimer() returns the time to wait rounded to whole ticks. With sub-tick precision, the exact
+     * expiry time of each timer (see Timer::getNextExpiryTimeNs()) is compared against the hardware cycle counter,
+     * so that a thread which can be woken with sub-tick precision (e.g. by a zct::PrecisionAlarm) can handle
+     * timers with microsecond-level jitter.
+     * 
+     * This assumes the hardware cycle counter and the system tick both count from boot, which is the case for
+     * the Zephyr system timer drivers.
+     * 
+     * zct::EventThread enables this when given a counter device, see EventThread::setPrecisionCounter().
+     * 
+     * @param isEnabled True to enable sub-tick precision.
+     */
+    void setSubTickPrecision(bool isEnabled);
+
+    /**
+     * Log the lateness statistics of the registered timers which have stats enabled (see Timer::setStatsEnabled()).
+     * 
+     * Logged at info level, regardless of the log level of the timer manager.
+     * 
+     * @param name If not nullptr, only the timers with this name are logged.
+     */
+    void logStats(const char* name = nullptr) const;
+
+    /**
+     * Tell the timer manager that a registered timer has been started, stopped or has had its expiry time updated.
+     * 
+     * Called by the Timer class, you should not need to call this yourself. Keeps the cached next expiring
+     * timer up-to-date so that getNextExpiringTimer() only has to scan all timers when the cached timer is
+     * stopped or moved later.
+     * 
+     * @param timer The timer that changed.
+     */
+    void onTimerChanged(Timer& timer);
+
+    /**
+     * Tell the timer manager that a number of registered timers have changed. Equivalent to calling onTimerChanged() for
+     * each timer, but the cached next expiring timer is updated in one go.
+     * 
+     * Called by the TimerGroup class, you should not need to call this yourself.
+     * 
+     * @param timers The timers that changed.
+     * @param numTimers The number of timers in the array.
+     */
+    void onTimersChanged(Timer* const* timers, uint32_t numTimers);
+
+    /**
+     * Set a function which wakes up the thread that owns this timer manager. Called when a timer command is posted
+     * from another thread or ISR with Timer::startAsync() or Timer::stopAsync(), so that a thread blocked waiting for
+     * the next timer expiry recalculates how long to wait.
+     * 
+     * zct::EventThread sets this up for its own timer manager, you should not need to call this yourself.
+     * 
+     * @param wakeCallback The function to call. Must be safe to call from any thread or ISR.
+     */
+    void setWakeCallback(std::function<void()> wakeCallback);
+
+    /**
+     * Tell the timer manager that a timer has a command pending. Called by the Timer class from any thread or ISR.
+     * 
+     * Wakes the owning thread if no commands were already pending. The pending commands are applied the next time
+     * getNextExpiringTimer() is called.
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     */
+    void onCommandPosted();
+
+    /**
+     * Check if any timers have commands pending that have not yet been applied.
+     * 
+     * THREAD SAFE. INTERRUPT SAFE.
+     * 
+     * @return true if there are commands pending.
+     */
+    bool hasPendingCommands() const;
+
+    /**
+     * Get a count which is incremented whenever a timer is registered, unregistered, started, stopped or has its expiry
+     * time updated. Compare two values to find out cheaply whether the next expiring timer may have changed.
+     * 
+     * @return The change count. Wraps around.
+     */
+    uint32_t getChangeCount() const;
+
 
 protected:
+
+    // Timer reads and writes its expiry time and period directly from the arrays below
+    friend class Timer;
+
+    /**
+     * Find the slot of the running timer with the earliest expiry time.
+     * 
+     * @return The slot of the earliest timer, or -1 if no timers are running.
+     */
+    int32_t findEarliestSlot() const;
+
+    /**
+     * Check if one running timer expires before another. With sub-tick precision, timers that expire on the same tick are
+     * ordered by their exact expiry times.
+     * 
+     * @param slotA The slot of the first timer.
+     * @param slotB The slot of the second timer.
+     * @return True if the timer in slotA expires before the timer in slotB.
+     */
+    bool isEarlier(uint32_t slotA, uint32_t slotB) const;
+
+    /**
+     * Get the time since boot with sub-tick precision.
+     * 
+     * @return The uptime in nanoseconds, from the hardware cycle counter if it is 64 bits wide, otherwise from the system tick.
+     */
+    static int64_t getPreciseUptimeNs();
+
+    /** Where the arrays below were allocated from, nullptr for the heap. */
+    Arena* m_arena;
+
+    /** The timer in each slot. Only used once the next expiring timer has been found. */
     Timer** m_timers;
+
+    /** The next expiry time of the timer in each slot, or NOT_RUNNING_TICKS if it is not running. */
+    int64_t* m_nextExpiryTimes_ticks;
+
+    /** The period of the timer in each slot, or -1 for a one-shot timer. */
+    int64_t* m_periods_ticks;
+
     uint32_t m_numTimers = 0;
     uint32_t m_maxNumTimers;
+
+    /**
+     * The slot of the running timer with the earliest expiry time, or -1 if no timers are running.
+     * Only valid if m_isNextExpiringTimerValid is true.
+     */
+    int32_t m_nextExpiringSlot = -1;
+
+    /**
+     * Set to false when the cached next expiring timer may no longer be the earliest, forcing a rescan.
+     */
+    bool m_isNextExpiringTimerValid = false;
+
+    /** See getChangeCount(). */
+    uint32_t m_changeCount = 0;
+
+    /** See setSubTickPrecision(). */
+    bool m_isSubTickPrecision = false;
+
+    /** Set to 1 from any thread or ISR when a timer command is posted. Cleared by the owning thread before applying the commands. */
+    atomic_t m_hasPendingCommands = ATOMIC_INIT(0);
+
+    /** Called when the first command is posted after the pending commands were last applied. See setWakeCallback(). */
+    std::function<void()> m_wakeCallback = nullptr;
 };
 
 } // namespace zct
@@ -12,11 +12,11 @@
 #pragma once
 
 // System includes
-#include <vector>
 #include <chrono>
 
 // Local includes
 #include "IWatchdog.hpp"
+#include "ZephyrCppToolkit/Core/StaticVector.hpp"
 
 namespace zct {
 
@@ -27,6 +27,11 @@ namespace zct {
  */
 class WatchdogMock : public IWatchdog {
 public:
+    /**
+     * @brief The maximum number of timeout channels which can be installed, installTimeout() fails after this.
+     */
+    static constexpr size_t MAX_NUM_CHANNELS = 8;
+
     /**
      * @brief Structure to hold information about an installed timeout channel.
      */
@@ -59,7 +64,7 @@ public:
      * @param userData User data to pass to callback (optional)
      * @param flags Reset behavior flags
      * @param options Configuration options
-     * @return Channel ID on success, negative error code on failure
+     * @return Channel ID on success, negative error code on failure (-ENOMEM if MAX_NUM_CHANNELS are already installed)
      */
     int installTimeout(uint32_t timeoutMs, 
                       CallbackFn callback = nullptr,
@@ -166,8 +171,8 @@ public:
     void mockReset();
 
 private:
-    std::vector<TimeoutChannel> m_channels;     ///< Installed timeout channels
-    std::vector<uint32_t> m_feedCounts;        ///< Feed count per channel
+    StaticVector<TimeoutChannel, MAX_NUM_CHANNELS> m_channels;  ///< Installed timeout channels
+    StaticVector<uint32_t, MAX_NUM_CHANNELS> m_feedCounts;      ///< Feed count per channel
     bool m_isSetup;                             ///< Whether setup() has been called
     bool m_isDisabled;                          ///< Whether disable() has been called
     Option m_globalOptions;                     ///< Global watchdog options
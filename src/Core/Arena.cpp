@@ -0,0 +1,90 @@
+#include <zephyr/logging/log.h>
+
+#include "ZephyrCppToolkit/Core/Arena.hpp"
+
+LOG_MODULE_REGISTER(zct_Arena, LOG_LEVEL_INF);
+
+namespace zct {
+
+Arena* Arena::s_default = nullptr;
+
+Arena::Arena(uint8_t* buffer, size_t size_bytes, const char* name) :
+    m_buffer(buffer),
+    m_size_bytes(size_bytes),
+    m_name(name)
+{
+}
+
+void* Arena::allocate(size_t size_bytes, size_t alignment)
+{
+    __ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of 2.");
+    auto guard = m_lock.lockGuard();
+    __ASSERT(!m_isFrozen, "Allocation of %u bytes from arena %s after it was frozen.", (unsigned)size_bytes, m_name);
+    if (m_isFrozen) {
+        return nullptr;
+    }
+
+    // Align the address, not the offset, since the buffer may not be aligned to everything
+    uintptr_t start = (reinterpret_cast<uintptr_t>(m_buffer) + m_used_bytes + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t newUsed_bytes = (start - reinterpret_cast<uintptr_t>(m_buffer)) + size_bytes;
+    __ASSERT(newUsed_bytes <= m_size_bytes, "Arena %s is full. Tried to allocate %u bytes with %u of %u used.",
+             m_name, (unsigned)size_bytes, (unsigned)m_used_bytes, (unsigned)m_size_bytes);
+    if (newUsed_bytes > m_size_bytes) {
+        return nullptr;
+    }
+    m_used_bytes = newUsed_bytes;
+    m_numAllocations++;
+    return reinterpret_cast<void*>(start);
+}
+
+void Arena::freeze()
+{
+    {
+        auto guard = m_lock.lockGuard();
+        m_isFrozen = true;
+    }
+    logUsage();
+}
+
+bool Arena::isFrozen() const
+{
+    return m_isFrozen;
+}
+
+size_t Arena::getUsed_bytes() const
+{
+    return m_used_bytes;
+}
+
+size_t Arena::getSize_bytes() const
+{
+    return m_size_bytes;
+}
+
+uint32_t Arena::getNumAllocations() const
+{
+    return m_numAllocations;
+}
+
+void Arena::logUsage() const
+{
+    LOG_INF("Arena %s: %u of %u bytes used by %u allocations.", m_name, (unsigned)m_used_bytes, (unsigned)m_size_bytes,
+            m_numAllocations);
+}
+
+void Arena::setDefault(Arena* arena)
+{
+    s_default = arena;
+}
+
+Arena* Arena::getDefault()
+{
+    return s_default;
+}
+
+Arena* Arena::resolve(Arena* arena)
+{
+    return arena != nullptr ? arena : s_default;
+}
+
+} // namespace zct
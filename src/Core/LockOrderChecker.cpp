@@ -0,0 +1,257 @@
+#include "ZephyrCppToolkit/Core/LockOrderChecker.hpp"
+
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+
+#include <zephyr/logging/log.h>
+
+#include "ZephyrCppToolkit/Core/Mutex.hpp"
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+#include "ZephyrCppToolkit/Core/StaticVector.hpp"
+
+LOG_MODULE_REGISTER(zct_LockOrderChecker, LOG_LEVEL_WRN);
+
+namespace zct {
+
+namespace {
+
+constexpr int NUM_EDGE_WORDS = (ZCT_LOCK_ORDER_MAX_MUTEXES + 31) / 32;
+
+/** The mutexes held by one thread, in the order they were locked. */
+struct HeldLocks {
+    k_tid_t thread = nullptr;
+    StaticVector<int16_t, ZCT_LOCK_ORDER_MAX_DEPTH> ids;
+};
+
+/** Protects everything below. A spinlock since the checker must not itself take part in lock ordering. */
+SpinLock s_lock;
+
+/** Maps graph IDs back to mutexes, so they can be named in reports. */
+Mutex* s_mutexes[ZCT_LOCK_ORDER_MAX_MUTEXES] = {};
+
+/** Adjacency matrix of the lock-order graph. Bit b of row a is set if a has been held while waiting on b. */
+uint32_t s_edges[ZCT_LOCK_ORDER_MAX_MUTEXES][NUM_EDGE_WORDS] = {};
+
+HeldLocks s_threads[ZCT_LOCK_ORDER_MAX_THREADS];
+
+bool s_isLimitWarned = false;
+
+LockOrderChecker::ViolationHandler s_violationHandler = nullptr;
+
+bool hasEdge(int from, int to)
+{
+    return (s_edges[from][to / 32] & (1u << (to % 32))) != 0;
+}
+
+/**
+ * Check if to can be reached from from by following edges. Depth first, with an explicit stack so it can't
+ * overflow the thread stack of whoever is locking.
+ */
+bool isReachable(int from, int to)
+{
+    uint32_t visited[NUM_EDGE_WORDS] = {};
+    StaticVector<int16_t, ZCT_LOCK_ORDER_MAX_MUTEXES> stack;
+    stack.push_back(static_cast<int16_t>(from));
+    visited[from / 32] |= 1u << (from % 32);
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        if (node == to) {
+            return true;
+        }
+        for (int next = 0; next < ZCT_LOCK_ORDER_MAX_MUTEXES; next++) {
+            if (hasEdge(node, next) && (visited[next / 32] & (1u << (next % 32))) == 0) {
+                visited[next / 32] |= 1u << (next % 32);
+                stack.push_back(static_cast<int16_t>(next));
+            }
+        }
+    }
+    return false;
+}
+
+/** Log the first time a fixed size limit is hit, after that stay quiet. */
+void warnLimit(const char* what)
+{
+    if (!s_isLimitWarned) {
+        s_isLimitWarned = true;
+        LOG_WRN("Lock order checking limit reached (%s). Some locks will not be checked.", what);
+    }
+}
+
+/** Get the held locks for the current thread, or nullptr if it holds none and isCreate is false. */
+HeldLocks* getHeldLocks(bool isCreate)
+{
+    k_tid_t thread = k_current_get();
+    HeldLocks* freeEntry = nullptr;
+    for (HeldLocks& entry : s_threads) {
+        if (entry.thread == thread) {
+            return &entry;
+        }
+        if (entry.thread == nullptr && freeEntry == nullptr) {
+            freeEntry = &entry;
+        }
+    }
+    if (!isCreate) {
+        return nullptr;
+    }
+    if (freeEntry == nullptr) {
+        warnLimit("ZCT_LOCK_ORDER_MAX_THREADS");
+        return nullptr;
+    }
+    freeEntry->thread = thread;
+    freeEntry->ids.clear();
+    return freeEntry;
+}
+
+void logMutex(const char* prefix, const Mutex& mutex)
+{
+    if (mutex.getName() != nullptr) {
+        LOG_ERR("%s: %s", prefix, mutex.getName());
+    } else {
+        LOG_ERR("%s: %p", prefix, (void*)&mutex);
+    }
+}
+
+void defaultViolationHandler(const Mutex& held, const Mutex& acquiring)
+{
+    LOG_ERR("Lock order inversion. Waiting on a mutex while holding one that has been locked after it elsewhere.");
+    logMutex("Held", held);
+    logMutex("Acquiring", acquiring);
+    __ASSERT(false, "Lock order inversion.");
+}
+
+} // namespace
+
+int LockOrderChecker::getId(Mutex& mutex)
+{
+    if (mutex.m_lockOrderId >= 0) {
+        return mutex.m_lockOrderId;
+    }
+    for (int id = 0; id < ZCT_LOCK_ORDER_MAX_MUTEXES; id++) {
+        if (s_mutexes[id] == nullptr) {
+            s_mutexes[id] = &mutex;
+            mutex.m_lockOrderId = static_cast<int16_t>(id);
+            return id;
+        }
+    }
+    warnLimit("ZCT_LOCK_ORDER_MAX_MUTEXES");
+    return -1;
+}
+
+void LockOrderChecker::onLocking(Mutex& mutex, bool isBlocking)
+{
+    if (!isBlocking) {
+        return;
+    }
+    Mutex* violationHeld = nullptr;
+    ViolationHandler handler = nullptr;
+    {
+        auto guard = s_lock.lockGuard();
+        HeldLocks* heldLocks = getHeldLocks(false);
+        if (heldLocks == nullptr) {
+            return;
+        }
+        int id = getId(mutex);
+        if (id < 0) {
+            return;
+        }
+        // Relocking a mutex we already hold can't block
+        for (int16_t heldId : heldLocks->ids) {
+            if (heldId == id) {
+                return;
+            }
+        }
+        for (int heldId : heldLocks->ids) {
+            if (hasEdge(heldId, id)) {
+                continue;
+            }
+            if (isReachable(id, heldId)) {
+                // Don't add the edge, so the graph stays acyclic and later checks stay meaningful
+                violationHeld = s_mutexes[heldId];
+                handler = s_violationHandler;
+                break;
+            }
+            s_edges[heldId][id / 32] |= 1u << (id % 32);
+        }
+    }
+
+    // Report outside of the spinlock, the handler logs and may assert
+    if (violationHeld != nullptr) {
+        if (handler != nullptr) {
+            handler(*violationHeld, mutex);
+        } else {
+            defaultViolationHandler(*violationHeld, mutex);
+        }
+    }
+}
+
+void LockOrderChecker::onLocked(Mutex& mutex)
+{
+    auto guard = s_lock.lockGuard();
+    int id = getId(mutex);
+    if (id < 0) {
+        return;
+    }
+    HeldLocks* heldLocks = getHeldLocks(true);
+    if (heldLocks == nullptr) {
+        return;
+    }
+    if (!heldLocks->ids.push_back(static_cast<int16_t>(id))) {
+        warnLimit("ZCT_LOCK_ORDER_MAX_DEPTH");
+    }
+}
+
+void LockOrderChecker::onUnlocking(Mutex& mutex)
+{
+    auto guard = s_lock.lockGuard();
+    HeldLocks* heldLocks = getHeldLocks(false);
+    if (heldLocks == nullptr || mutex.m_lockOrderId < 0) {
+        return;
+    }
+    // Mutexes don't have to be unlocked in reverse order, so remove the most recent matching entry wherever it is
+    for (size_t i = heldLocks->ids.size(); i > 0; i--) {
+        if (heldLocks->ids[i - 1] == mutex.m_lockOrderId) {
+            heldLocks->ids.erase(heldLocks->ids.begin() + (i - 1));
+            break;
+        }
+    }
+    if (heldLocks->ids.empty()) {
+        heldLocks->thread = nullptr;
+    }
+}
+
+void LockOrderChecker::onDestroyed(Mutex& mutex)
+{
+    auto guard = s_lock.lockGuard();
+    int id = mutex.m_lockOrderId;
+    if (id < 0) {
+        return;
+    }
+    for (int other = 0; other < ZCT_LOCK_ORDER_MAX_MUTEXES; other++) {
+        s_edges[other][id / 32] &= ~(1u << (id % 32));
+    }
+    for (int word = 0; word < NUM_EDGE_WORDS; word++) {
+        s_edges[id][word] = 0;
+    }
+    s_mutexes[id] = nullptr;
+    mutex.m_lockOrderId = -1;
+}
+
+void LockOrderChecker::setViolationHandler(ViolationHandler handler)
+{
+    auto guard = s_lock.lockGuard();
+    s_violationHandler = handler;
+}
+
+void LockOrderChecker::reset()
+{
+    auto guard = s_lock.lockGuard();
+    for (int id = 0; id < ZCT_LOCK_ORDER_MAX_MUTEXES; id++) {
+        for (int word = 0; word < NUM_EDGE_WORDS; word++) {
+            s_edges[id][word] = 0;
+        }
+    }
+}
+
+} // namespace zct
+
+#endif
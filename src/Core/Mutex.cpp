@@ -1,11 +1,21 @@
+#include <cstring>
+
 #include <zephyr/logging/log.h>
 
 #include "ZephyrCppToolkit/Core/Mutex.hpp"
+#include "ZephyrCppToolkit/Core/Tracing.hpp"
 
-LOG_MODULE_REGISTER(zct_Mutex, LOG_LEVEL_WRN);
+LOG_MODULE_REGISTER(zct_Mutex, LOG_LEVEL_INF);
 
 namespace zct {
 
+/**
+ * Protects the list of all Mutex objects. A raw k_mutex, since a zct::Mutex would have to register itself, and not a
+ * spinlock since forEach() calls user code with it held.
+ */
+static K_MUTEX_DEFINE(s_mutexRegistryMutex);
+
+Mutex* Mutex::s_first = nullptr;
 
 //================================================================================================//
 // MutexLockGuard
@@ -16,14 +26,35 @@ MutexLockGuard::MutexLockGuard(Mutex& mutex, k_timeout_t timeout, int& mutexRc)
 {
     // Try and lock the mutex
     LOG_DBG("Locking mutex: %p", mutex.getZephyrMutex());
-    int mutexRcTemp = k_mutex_lock(mutex.getZephyrMutex(), timeout);
+    ZCT_TRACE("zct_mutex_wait", &mutex, timeout.ticks);
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+    LockOrderChecker::onLocking(mutex, !K_TIMEOUT_EQ(timeout, K_NO_WAIT));
+#endif
+    int mutexRcTemp;
+    if (mutex.m_isStatsEnabled) {
+        mutexRcTemp = mutex.lockWithStats(timeout);
+    } else {
+        mutexRcTemp = k_mutex_lock(mutex.getZephyrMutex(), timeout);
+    }
+    ZCT_TRACE("zct_mutex_locked", &mutex, mutexRcTemp);
     LOG_DBG("k_mutex_lock returned: %d", mutexRcTemp);
     if (mutexRcTemp == 0) {
         m_didGetLock = true;
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+        LockOrderChecker::onLocked(mutex);
+#endif
     }
     mutexRc = mutexRcTemp;
 }
 
+MutexLockGuard::MutexLockGuard(MutexLockGuard&& other)
+    : m_mutex(other.m_mutex),
+      m_didGetLock(other.m_didGetLock)
+{
+    // The lock now belongs to this guard
+    other.m_didGetLock = false;
+}
+
 MutexLockGuard::~MutexLockGuard()
 {
     LOG_DBG("MutexLockGuard destructor called. m_didGetLock: %d", m_didGetLock);
@@ -31,6 +62,13 @@ MutexLockGuard::~MutexLockGuard()
     // mutex.
     if (m_didGetLock) {
         LOG_DBG("Unlocking mutex: %p", m_mutex.getZephyrMutex());
+        ZCT_TRACE("zct_mutex_unlock", &m_mutex, 0);
+        if (m_mutex.m_isLockTimeValid && m_mutex.getZephyrMutex()->lock_count == 1) {
+            m_mutex.recordUnlock();
+        }
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+        LockOrderChecker::onUnlocking(m_mutex);
+#endif
         int mutexRc = k_mutex_unlock(m_mutex.getZephyrMutex());
         LOG_DBG("k_mutex_unlock returned: %d", mutexRc);
         __ASSERT_NO_MSG(mutexRc == 0);
@@ -46,14 +84,32 @@ bool MutexLockGuard::didGetLock() const
 // Mutex
 //================================================================================================//
 
-Mutex::Mutex()
+Mutex::Mutex(const char* name) :
+    m_name(name)
 {
     // Create Zephyr mutex
     k_mutex_init(&m_zephyrMutex);
+
+    // Add to the front of the registry
+    k_mutex_lock(&s_mutexRegistryMutex, K_FOREVER);
+    m_next = s_first;
+    s_first = this;
+    k_mutex_unlock(&s_mutexRegistryMutex);
 }
 
 Mutex::~Mutex()
 {
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+    LockOrderChecker::onDestroyed(*this);
+#endif
+    k_mutex_lock(&s_mutexRegistryMutex, K_FOREVER);
+    for (Mutex** mutex = &s_first; *mutex != nullptr; mutex = &(*mutex)->m_next) {
+        if (*mutex == this) {
+            *mutex = m_next;
+            break;
+        }
+    }
+    k_mutex_unlock(&s_mutexRegistryMutex);
 }
 
 MutexLockGuard Mutex::lockGuard(k_timeout_t timeout)
@@ -69,4 +125,123 @@ struct k_mutex* Mutex::getZephyrMutex()
     return &m_zephyrMutex;
 }
 
-} // namespace zct
\ No newline at end of file
+const char* Mutex::getName() const
+{
+    return m_name;
+}
+
+void Mutex::setStatsEnabled(bool isEnabled)
+{
+    m_isStatsEnabled = isEnabled;
+}
+
+bool Mutex::getStatsEnabled() const
+{
+    return m_isStatsEnabled;
+}
+
+Mutex::Stats Mutex::getStats() const
+{
+    auto guard = m_statsLock.lockGuard();
+    Stats stats = m_stats;
+    stats.totalWaitTime_us = k_cyc_to_us_floor64(m_totalWaitTime_cycles);
+    stats.maxWaitTime_us = k_cyc_to_us_floor32(m_maxWaitTime_cycles);
+    stats.maxHoldTime_us = k_cyc_to_us_floor32(m_maxHoldTime_cycles);
+#if defined(CONFIG_THREAD_NAME)
+    stats.lastOwnerName = m_lastOwnerName;
+#endif
+    return stats;
+}
+
+void Mutex::resetStats()
+{
+    auto guard = m_statsLock.lockGuard();
+    m_stats = Stats{};
+    m_totalWaitTime_cycles = 0;
+    m_maxWaitTime_cycles = 0;
+    m_maxHoldTime_cycles = 0;
+}
+
+int Mutex::lockWithStats(k_timeout_t timeout)
+{
+    // Try without waiting first, so we can tell if another thread holds the mutex
+    uint32_t startTime_cycles = k_cycle_get_32();
+    int rc = k_mutex_lock(&m_zephyrMutex, K_NO_WAIT);
+    bool isContended = false;
+    if (rc != 0 && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        isContended = true;
+        rc = k_mutex_lock(&m_zephyrMutex, timeout);
+    }
+    if (rc != 0) {
+        return rc;
+    }
+    uint32_t lockTime_cycles = k_cycle_get_32();
+
+    // Recursive locks by the owner are not new acquisitions
+    if (m_zephyrMutex.lock_count != 1) {
+        return rc;
+    }
+    m_lockTime_cycles = lockTime_cycles;
+    m_isLockTimeValid = true;
+
+    k_tid_t owner = k_current_get();
+    auto guard = m_statsLock.lockGuard();
+    m_stats.numAcquisitions++;
+    if (isContended) {
+        uint32_t waitTime_cycles = lockTime_cycles - startTime_cycles;
+        m_stats.numContended++;
+        m_totalWaitTime_cycles += waitTime_cycles;
+        if (waitTime_cycles > m_maxWaitTime_cycles) {
+            m_maxWaitTime_cycles = waitTime_cycles;
+        }
+    }
+    if (owner != m_lastOwner) {
+        m_lastOwner = owner;
+#if defined(CONFIG_THREAD_NAME)
+        const char* ownerName = k_thread_name_get(owner);
+        strncpy(m_lastOwnerName, ownerName != nullptr ? ownerName : "", sizeof(m_lastOwnerName) - 1);
+#endif
+    }
+    return rc;
+}
+
+void Mutex::recordUnlock()
+{
+    uint32_t holdTime_cycles = k_cycle_get_32() - m_lockTime_cycles;
+    m_isLockTimeValid = false;
+
+    auto guard = m_statsLock.lockGuard();
+    if (holdTime_cycles > m_maxHoldTime_cycles) {
+        m_maxHoldTime_cycles = holdTime_cycles;
+    }
+}
+
+void Mutex::forEach(const std::function<void(Mutex&)>& func)
+{
+    k_mutex_lock(&s_mutexRegistryMutex, K_FOREVER);
+    for (Mutex* mutex = s_first; mutex != nullptr; mutex = mutex->m_next) {
+        func(*mutex);
+    }
+    k_mutex_unlock(&s_mutexRegistryMutex);
+}
+
+void Mutex::logAll()
+{
+    forEach([](Mutex& mutex) {
+        if (!mutex.getStatsEnabled()) {
+            return;
+        }
+        Stats stats = mutex.getStats();
+        if (mutex.getName() != nullptr) {
+            LOG_INF("Mutex %s: acquisitions=%u contended=%u wait total=%lluus max=%uus hold max=%uus last owner=%s",
+                    mutex.getName(), stats.numAcquisitions, stats.numContended, stats.totalWaitTime_us,
+                    stats.maxWaitTime_us, stats.maxHoldTime_us, stats.lastOwnerName);
+        } else {
+            LOG_INF("Mutex %p: acquisitions=%u contended=%u wait total=%lluus max=%uus hold max=%uus last owner=%s",
+                    (void*)&mutex, stats.numAcquisitions, stats.numContended, stats.totalWaitTime_us,
+                    stats.maxWaitTime_us, stats.maxHoldTime_us, stats.lastOwnerName);
+        }
+    });
+}
+
+} // namespace zct
@@ -0,0 +1,201 @@
+#include <zephyr/logging/log.h>
+
+#include "ZephyrCppToolkit/Core/SharedMutex.hpp"
+
+LOG_MODULE_REGISTER(zct_SharedMutex, LOG_LEVEL_WRN);
+
+namespace zct {
+
+//================================================================================================//
+// SharedMutexReadGuard
+//================================================================================================//
+
+SharedMutexReadGuard::SharedMutexReadGuard(SharedMutex& sharedMutex, k_timeout_t timeout)
+    : m_sharedMutex(sharedMutex)
+{
+    m_didGetLock = (sharedMutex.lockRead(timeout) == 0);
+}
+
+SharedMutexReadGuard::SharedMutexReadGuard(SharedMutexReadGuard&& other)
+    : m_sharedMutex(other.m_sharedMutex),
+      m_didGetLock(other.m_didGetLock)
+{
+    // The lock now belongs to this guard
+    other.m_didGetLock = false;
+}
+
+SharedMutexReadGuard::~SharedMutexReadGuard()
+{
+    if (m_didGetLock) {
+        m_sharedMutex.unlockRead();
+    }
+}
+
+bool SharedMutexReadGuard::didGetLock() const
+{
+    return m_didGetLock;
+}
+
+//================================================================================================//
+// SharedMutexWriteGuard
+//================================================================================================//
+
+SharedMutexWriteGuard::SharedMutexWriteGuard(SharedMutex& sharedMutex, k_timeout_t timeout)
+    : m_sharedMutex(sharedMutex)
+{
+    m_didGetLock = (sharedMutex.lockWrite(timeout) == 0);
+}
+
+SharedMutexWriteGuard::SharedMutexWriteGuard(SharedMutexWriteGuard&& other)
+    : m_sharedMutex(other.m_sharedMutex),
+      m_didGetLock(other.m_didGetLock)
+{
+    // The lock now belongs to this guard
+    other.m_didGetLock = false;
+}
+
+SharedMutexWriteGuard::~SharedMutexWriteGuard()
+{
+    if (m_didGetLock) {
+        m_sharedMutex.unlockWrite();
+    }
+}
+
+bool SharedMutexWriteGuard::didGetLock() const
+{
+    return m_didGetLock;
+}
+
+//================================================================================================//
+// SharedMutex
+//================================================================================================//
+
+SharedMutex::SharedMutex(Preference preference, bool isPriorityInheritance)
+    : m_preference(preference),
+      m_isPriorityInheritance(isPriorityInheritance)
+{
+    k_mutex_init(&m_stateMutex);
+    k_condvar_init(&m_readersCondVar);
+    k_condvar_init(&m_writersCondVar);
+    k_mutex_init(&m_writerMutex);
+}
+
+SharedMutex::~SharedMutex()
+{
+}
+
+SharedMutexReadGuard SharedMutex::readGuard(k_timeout_t timeout)
+{
+    return SharedMutexReadGuard(*this, timeout);
+}
+
+SharedMutexWriteGuard SharedMutex::writeGuard(k_timeout_t timeout)
+{
+    return SharedMutexWriteGuard(*this, timeout);
+}
+
+uint32_t SharedMutex::getNumReaders()
+{
+    k_mutex_lock(&m_stateMutex, K_FOREVER);
+    uint32_t numReaders = m_numReaders;
+    k_mutex_unlock(&m_stateMutex);
+    return numReaders;
+}
+
+int SharedMutex::lockRead(k_timeout_t timeout)
+{
+    // Waiting on the condition variable several times must not extend the total timeout
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+
+    if (m_isPriorityInheritance) {
+        // If a writer holds the lock, this blocks on the writer mutex and so raises the writer's priority to ours.
+        // We don't need to keep it, readers don't exclude each other.
+        if (k_mutex_lock(&m_writerMutex, timeout) != 0) {
+            return -EAGAIN;
+        }
+        k_mutex_unlock(&m_writerMutex);
+    }
+
+    if (k_mutex_lock(&m_stateMutex, sys_timepoint_timeout(deadline)) != 0) {
+        return -EAGAIN;
+    }
+    while (m_isWriterActive || (m_preference == Preference::Writer && m_numWaitingWriters > 0)) {
+        if (k_condvar_wait(&m_readersCondVar, &m_stateMutex, sys_timepoint_timeout(deadline)) != 0) {
+            k_mutex_unlock(&m_stateMutex);
+            return -EAGAIN;
+        }
+    }
+    m_numReaders++;
+    k_mutex_unlock(&m_stateMutex);
+    return 0;
+}
+
+void SharedMutex::unlockRead()
+{
+    k_mutex_lock(&m_stateMutex, K_FOREVER);
+    __ASSERT(m_numReaders > 0, "Shared mutex unlocked for reading when no readers hold it.");
+    m_numReaders--;
+    if (m_numReaders == 0) {
+        // Last reader out lets a writer in
+        k_condvar_signal(&m_writersCondVar);
+    }
+    k_mutex_unlock(&m_stateMutex);
+}
+
+int SharedMutex::lockWrite(k_timeout_t timeout)
+{
+    // Waiting on the condition variable several times must not extend the total timeout
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+
+    if (m_isPriorityInheritance) {
+        // Held until unlockWrite(), so that anyone waiting on us raises our priority
+        if (k_mutex_lock(&m_writerMutex, timeout) != 0) {
+            return -EAGAIN;
+        }
+    }
+
+    if (k_mutex_lock(&m_stateMutex, sys_timepoint_timeout(deadline)) != 0) {
+        if (m_isPriorityInheritance) {
+            k_mutex_unlock(&m_writerMutex);
+        }
+        return -EAGAIN;
+    }
+    m_numWaitingWriters++;
+    while (m_isWriterActive || m_numReaders > 0) {
+        if (k_condvar_wait(&m_writersCondVar, &m_stateMutex, sys_timepoint_timeout(deadline)) != 0) {
+            m_numWaitingWriters--;
+            if (m_numWaitingWriters == 0) {
+                // Readers may have been held back by us waiting
+                k_condvar_broadcast(&m_readersCondVar);
+            }
+            k_mutex_unlock(&m_stateMutex);
+            if (m_isPriorityInheritance) {
+                k_mutex_unlock(&m_writerMutex);
+            }
+            return -EAGAIN;
+        }
+    }
+    m_numWaitingWriters--;
+    m_isWriterActive = true;
+    k_mutex_unlock(&m_stateMutex);
+    return 0;
+}
+
+void SharedMutex::unlockWrite()
+{
+    k_mutex_lock(&m_stateMutex, K_FOREVER);
+    __ASSERT(m_isWriterActive, "Shared mutex unlocked for writing when no writer holds it.");
+    m_isWriterActive = false;
+    if (m_preference == Preference::Writer && m_numWaitingWriters > 0) {
+        k_condvar_signal(&m_writersCondVar);
+    } else {
+        k_condvar_broadcast(&m_readersCondVar);
+        k_condvar_signal(&m_writersCondVar);
+    }
+    k_mutex_unlock(&m_stateMutex);
+    if (m_isPriorityInheritance) {
+        k_mutex_unlock(&m_writerMutex);
+    }
+}
+
+} // namespace zct
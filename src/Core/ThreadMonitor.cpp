@@ -0,0 +1,112 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "ZephyrCppToolkit/Core/ThreadMonitor.hpp"
+
+LOG_MODULE_REGISTER(zct_ThreadMonitor, LOG_LEVEL_INF);
+
+namespace zct {
+
+/** Protects the registry. A mutex rather than a spinlock, since forEach() calls user code with it held. */
+static K_MUTEX_DEFINE(s_threadMonitorRegistryMutex);
+
+ThreadMonitor* ThreadMonitor::s_first = nullptr;
+
+ThreadMonitor::ThreadMonitor(const char* name, size_t stackSize_bytes) :
+    m_name(name),
+    m_stackSize_bytes(stackSize_bytes)
+{
+    // Add to the front of the registry
+    k_mutex_lock(&s_threadMonitorRegistryMutex, K_FOREVER);
+    m_next = s_first;
+    s_first = this;
+    k_mutex_unlock(&s_threadMonitorRegistryMutex);
+}
+
+ThreadMonitor::~ThreadMonitor()
+{
+    k_mutex_lock(&s_threadMonitorRegistryMutex, K_FOREVER);
+    for (ThreadMonitor** monitor = &s_first; *monitor != nullptr; monitor = &(*monitor)->m_next) {
+        if (*monitor == this) {
+            *monitor = m_next;
+            break;
+        }
+    }
+    k_mutex_unlock(&s_threadMonitorRegistryMutex);
+}
+
+void ThreadMonitor::setThread(struct k_thread* thread)
+{
+    m_thread = thread;
+}
+
+int ThreadMonitor::getStats(Stats& stats)
+{
+    if (m_thread == nullptr) {
+        return -ESRCH;
+    }
+    stats = Stats{};
+    stats.stackSize_bytes = m_stackSize_bytes;
+
+#if defined(CONFIG_THREAD_STACK_INFO)
+    // Report the size the kernel uses, which can differ from the requested size because of alignment and reserved areas.
+    // k_thread_stack_space_get() measures against this size too.
+    stats.stackSize_bytes = m_thread->stack_info.size;
+#if defined(CONFIG_INIT_STACKS)
+    size_t unused_bytes;
+    if (k_thread_stack_space_get(m_thread, &unused_bytes) == 0) {
+        stats.stackHighWater_bytes = m_thread->stack_info.size - unused_bytes;
+    }
+#endif
+#endif
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+    k_thread_runtime_stats_t threadStats;
+    k_thread_runtime_stats_t allStats;
+    if (k_thread_runtime_stats_get(m_thread, &threadStats) == 0 && k_thread_runtime_stats_all_get(&allStats) == 0) {
+        stats.runtime_us = k_cyc_to_us_floor64(threadStats.execution_cycles);
+
+        // CPU load is the share of all cycles (including idle) used by this thread since the last call
+        k_mutex_lock(&s_threadMonitorRegistryMutex, K_FOREVER);
+        uint64_t threadCycles = threadStats.execution_cycles - m_lastThreadCycles;
+        uint64_t totalCycles = allStats.execution_cycles - m_lastTotalCycles;
+        m_lastThreadCycles = threadStats.execution_cycles;
+        m_lastTotalCycles = allStats.execution_cycles;
+        k_mutex_unlock(&s_threadMonitorRegistryMutex);
+        if (totalCycles != 0) {
+            stats.cpuLoad_percent = static_cast<uint8_t>((threadCycles * 100) / totalCycles);
+        }
+    }
+#endif
+    return 0;
+}
+
+const char* ThreadMonitor::getName() const
+{
+    return m_name;
+}
+
+void ThreadMonitor::forEach(const std::function<void(ThreadMonitor&)>& func)
+{
+    k_mutex_lock(&s_threadMonitorRegistryMutex, K_FOREVER);
+    for (ThreadMonitor* monitor = s_first; monitor != nullptr; monitor = monitor->m_next) {
+        func(*monitor);
+    }
+    k_mutex_unlock(&s_threadMonitorRegistryMutex);
+}
+
+void ThreadMonitor::logAll()
+{
+    forEach([](ThreadMonitor& monitor) {
+        Stats stats;
+        if (monitor.getStats(stats) != 0) {
+            LOG_INF("Thread \"%s\": not started.", monitor.getName());
+            return;
+        }
+        LOG_INF("Thread \"%s\": stack %zu/%zu bytes, runtime %llu us, CPU load %u%%.",
+            monitor.getName(), stats.stackHighWater_bytes, stats.stackSize_bytes,
+            (unsigned long long)stats.runtime_us, stats.cpuLoad_percent);
+    });
+}
+
+} // namespace zct
@@ -0,0 +1,240 @@
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Events/CalendarScheduler.hpp"
+
+namespace zct {
+
+LOG_MODULE_REGISTER(zct_CalendarScheduler, LOG_LEVEL_DBG);
+
+namespace {
+
+constexpr int64_t SECONDS_PER_MINUTE = 60;
+constexpr int64_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+/**
+ * How many months to search for the next due time. The Gregorian calendar (weekdays included) repeats every 400 years,
+ * so a rule which is not due within 400 years is never due. Rules like "the 29th of February on a Monday" can take
+ * up to 40 years to come round.
+ */
+constexpr int32_t MAX_NUM_MONTHS_TO_SEARCH = 400 * 12 + 1;
+
+/** Find the first set bit at or after a position, or -1 if there is none. */
+int32_t findNextBit(uint64_t bits, uint32_t from, uint32_t numBits) {
+    for (uint32_t i = from; i < numBits; i++) {
+        if (bits & (1ULL << i)) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+bool isLeapYear(int64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+uint32_t getNumDaysInMonth(int64_t year, uint32_t month) {
+    static constexpr uint8_t NUM_DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && isLeapYear(year)) ? 29 : NUM_DAYS[month - 1];
+}
+
+/** Convert a date to days since the Unix epoch. From Howard Hinnant's date algorithms. */
+int64_t daysFromCivil(int64_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/** Convert days since the Unix epoch to a date. The inverse of daysFromCivil(). */
+void civilFromDays(int64_t days, int64_t& year, uint32_t& month, uint32_t& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    day = static_cast<uint32_t>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    month = static_cast<uint32_t>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+/** Get the weekday (0 is Sunday) of a day since the Unix epoch, which was a Thursday. */
+uint32_t getWeekday(int64_t days) {
+    return static_cast<uint32_t>(((days % 7) + 11) % 7);
+}
+
+} // namespace
+
+CalendarScheduler::CalendarScheduler(TimerManager& timerManager, uint32_t maxNumRules, Arena* arena) :
+    m_maxNumRules(maxNumRules),
+    m_arena(Arena::resolve(arena)),
+    m_timer("CalendarScheduler", [this]() { onTimerExpiry(); }, timerManager)
+{
+    m_rules = Arena::newArray<RuleSlot>(m_arena, maxNumRules);
+    __ASSERT_NO_MSG(m_rules != nullptr);
+}
+
+CalendarScheduler::CalendarScheduler(TimerManager& timerManager, RuleSlot* rules, uint32_t maxNumRules) :
+    m_rules(rules),
+    m_maxNumRules(maxNumRules),
+    m_arena(nullptr),
+    m_isStorageOwned(false),
+    m_timer("CalendarScheduler", [this]() { onTimerExpiry(); }, timerManager)
+{
+}
+
+CalendarScheduler::~CalendarScheduler() {
+    // Free the memory allocated in constructor.
+    if (m_isStorageOwned) {
+        Arena::deleteArray(m_arena, m_rules, m_maxNumRules);
+    }
+}
+
+int CalendarScheduler::addRule(const Rule& rule, std::function<void()> callback) {
+    LOG_MODULE_DECLARE(zct_CalendarScheduler, ZCT_CALENDAR_SCHEDULER_LOG_LEVEL);
+    // Search from the epoch rather than now so that rules can be added before the time is set
+    if (findNextDueTime(rule, 0) == -1) {
+        LOG_ERR("Rule can never be due.");
+        return -EINVAL;
+    }
+    for (uint32_t i = 0; i < m_maxNumRules; i++) {
+        RuleSlot& slot = m_rules[i];
+        if (slot.isUsed) {
+            continue;
+        }
+        slot.rule = rule;
+        slot.callback = callback;
+        slot.isUsed = true;
+        slot.nextDueTime_s = -1;
+        if (m_isTimeSet) {
+            slot.nextDueTime_s = findNextDueTime(rule, getTime() / 1000);
+            armTimer();
+        }
+        return static_cast<int>(i);
+    }
+    LOG_ERR("Max. number of rules of %u reached.", m_maxNumRules);
+    return -ENOMEM;
+}
+
+void CalendarScheduler::removeRule(int ruleId) {
+    __ASSERT(ruleId >= 0 && static_cast<uint32_t>(ruleId) < m_maxNumRules, "Invalid rule ID %d.", ruleId);
+    m_rules[ruleId].isUsed = false;
+    m_rules[ruleId].callback = nullptr;
+    m_rules[ruleId].nextDueTime_s = -1;
+    armTimer();
+}
+
+void CalendarScheduler::setTime(int64_t unixTime_ms) {
+    LOG_MODULE_DECLARE(zct_CalendarScheduler, ZCT_CALENDAR_SCHEDULER_LOG_LEVEL);
+    LOG_DBG("Setting time to %lld ms.", unixTime_ms);
+    m_timeOffset_ms = unixTime_ms - k_uptime_get();
+    m_isTimeSet = true;
+    // The time may have jumped, so reschedule every rule from the new time
+    int64_t now_s = unixTime_ms / 1000;
+    for (uint32_t i = 0; i < m_maxNumRules; i++) {
+        if (m_rules[i].isUsed) {
+            m_rules[i].nextDueTime_s = findNextDueTime(m_rules[i].rule, now_s);
+        }
+    }
+    armTimer();
+}
+
+bool CalendarScheduler::isTimeSet() const {
+    return m_isTimeSet;
+}
+
+int64_t CalendarScheduler::getTime() const {
+    if (!m_isTimeSet) {
+        return -1;
+    }
+    return k_uptime_get() + m_timeOffset_ms;
+}
+
+int64_t CalendarScheduler::findNextDueTime(const Rule& rule, int64_t afterUnixTime_s) {
+    // Rules are due at the start of a minute, so start from the start of the next minute
+    int64_t searchFrom_s = (afterUnixTime_s / SECONDS_PER_MINUTE + 1) * SECONDS_PER_MINUTE;
+    int64_t day = searchFrom_s / SECONDS_PER_DAY;
+    int64_t secondsIntoDay = searchFrom_s % SECONDS_PER_DAY;
+    uint32_t fromHour = static_cast<uint32_t>(secondsIntoDay / 3600);
+    uint32_t fromMinute = static_cast<uint32_t>((secondsIntoDay % 3600) / 60);
+
+    int64_t year;
+    uint32_t month;
+    uint32_t fromDayOfMonth;
+    civilFromDays(day, year, month, fromDayOfMonth);
+
+    // Go month by month, skipping months which don't match, and then through the matching days in each month.
+    // Most rules are found on the first day.
+    for (int32_t i = 0; i < MAX_NUM_MONTHS_TO_SEARCH; i++) {
+        if (rule.months & (1U << month)) {
+            uint32_t numDaysInMonth = getNumDaysInMonth(year, month);
+            int32_t dayOfMonth = findNextBit(rule.daysOfMonth, i == 0 ? fromDayOfMonth : 1, numDaysInMonth + 1);
+            while (dayOfMonth != -1) {
+                int64_t candidateDay = daysFromCivil(year, month, static_cast<uint32_t>(dayOfMonth));
+                if (rule.weekdays & (1U << getWeekday(candidateDay))) {
+                    // Only the first day is partially in the past
+                    bool isFirstDay = (candidateDay == day);
+                    int32_t hour = findNextBit(rule.hours, isFirstDay ? fromHour : 0, 24);
+                    while (hour != -1) {
+                        bool isFirstHour = (isFirstDay && static_cast<uint32_t>(hour) == fromHour);
+                        int32_t minute = findNextBit(rule.minutes, isFirstHour ? fromMinute : 0, 60);
+                        if (minute != -1) {
+                            return candidateDay * SECONDS_PER_DAY + hour * 3600 + minute * SECONDS_PER_MINUTE;
+                        }
+                        hour = findNextBit(rule.hours, hour + 1, 24);
+                    }
+                }
+                dayOfMonth = findNextBit(rule.daysOfMonth, dayOfMonth + 1, numDaysInMonth + 1);
+            }
+        }
+        month++;
+        if (month > 12) {
+            month = 1;
+            year++;
+        }
+    }
+    return -1;
+}
+
+void CalendarScheduler::onTimerExpiry() {
+    LOG_MODULE_DECLARE(zct_CalendarScheduler, ZCT_CALENDAR_SCHEDULER_LOG_LEVEL);
+    int64_t now_s = getTime() / 1000;
+    for (uint32_t i = 0; i < m_maxNumRules; i++) {
+        RuleSlot& slot = m_rules[i];
+        if (!slot.isUsed || slot.nextDueTime_s == -1 || slot.nextDueTime_s > now_s) {
+            continue;
+        }
+        // Schedule from when it was due rather than now, so a late expiry does not skip the next due time
+        slot.nextDueTime_s = findNextDueTime(slot.rule, slot.nextDueTime_s);
+        LOG_DBG("Rule %u is due. Next due at %lld s.", i, slot.nextDueTime_s);
+        if (slot.callback) {
+            slot.callback();
+        }
+    }
+    armTimer();
+}
+
+void CalendarScheduler::armTimer() {
+    int64_t nextDueTime_s = -1;
+    for (uint32_t i = 0; i < m_maxNumRules; i++) {
+        const RuleSlot& slot = m_rules[i];
+        if (slot.isUsed && slot.nextDueTime_s != -1 && (nextDueTime_s == -1 || slot.nextDueTime_s < nextDueTime_s)) {
+            nextDueTime_s = slot.nextDueTime_s;
+        }
+    }
+    if (!m_isTimeSet || nextDueTime_s == -1) {
+        m_timer.stop();
+        return;
+    }
+    int64_t delay_ms = nextDueTime_s * 1000 - getTime();
+    m_timer.start(delay_ms > 0 ? delay_ms : 0, -1);
+}
+
+} // namespace zct
@@ -0,0 +1,108 @@
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <cstring>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Events/EventTraceRecorder.hpp"
+
+namespace zct {
+
+LOG_MODULE_REGISTER(zct_EventTraceRecorder, LOG_LEVEL_DBG);
+
+EventTraceRecorder::EventTraceRecorder(size_t maxNumRecords, size_t maxPayloadSize, Arena* arena) :
+    m_maxNumRecords(maxNumRecords),
+    m_maxPayloadSize(maxPayloadSize),
+    m_arena(Arena::resolve(arena)),
+    m_lock{}
+{
+    LOG_MODULE_DECLARE(zct_EventTraceRecorder, ZCT_EVENT_TRACE_RECORDER_LOG_LEVEL);
+    __ASSERT(maxNumRecords > 0, "Must be able to store at least one record.");
+    __ASSERT(maxPayloadSize <= UINT8_MAX, "Max. payload size of %zu is too large.", maxPayloadSize);
+
+    // Round the slot size up so that every header in the buffer is correctly aligned
+    m_slotSize = ROUND_UP(sizeof(RecordHeader) + maxPayloadSize, alignof(RecordHeader));
+    m_buffer = Arena::newArray<uint8_t>(m_arena, m_slotSize * maxNumRecords);
+    __ASSERT_NO_MSG(m_buffer != nullptr);
+    LOG_DBG("Allocated %zu bytes for %zu trace records.", m_slotSize * maxNumRecords, maxNumRecords);
+}
+
+EventTraceRecorder::~EventTraceRecorder() {
+    // Free the memory allocated in constructor.
+    Arena::deleteArray(m_arena, m_buffer, m_slotSize * m_maxNumRecords);
+}
+
+void EventTraceRecorder::record(SourceType sourceType, uintptr_t sourceId, const void* payload, size_t payloadSize) {
+    if (!m_isEnabled) {
+        return;
+    }
+    int64_t timestamp_ticks = k_uptime_ticks();
+
+    auto guard = m_lock.lockGuard();
+    uint8_t* slot = getSlot(m_head);
+    RecordHeader* header = reinterpret_cast<RecordHeader*>(slot);
+    header->timestamp_ticks = timestamp_ticks;
+    header->sourceId = sourceId;
+    header->sourceType = sourceType;
+    // Payloads which don't fit are dropped entirely, a truncated event is no use for replay
+    if (payload != nullptr && payloadSize <= m_maxPayloadSize) {
+        header->payloadSize = static_cast<uint8_t>(payloadSize);
+        memcpy(slot + sizeof(RecordHeader), payload, payloadSize);
+    } else {
+        header->payloadSize = 0;
+    }
+
+    m_head = (m_head + 1) % m_maxNumRecords;
+    if (m_numRecords < m_maxNumRecords) {
+        m_numRecords++;
+    } else {
+        m_numOverwrittenRecords++;
+    }
+}
+
+bool EventTraceRecorder::getRecord(size_t index, RecordHeader& header, uint8_t* payloadBuf, size_t payloadBufSize) const {
+    auto guard = m_lock.lockGuard();
+    if (index >= m_numRecords) {
+        return false;
+    }
+    // The oldest record sits just after the newest one once the buffer has wrapped
+    size_t oldestSlot = (m_head + m_maxNumRecords - m_numRecords) % m_maxNumRecords;
+    const uint8_t* slot = getSlot((oldestSlot + index) % m_maxNumRecords);
+    memcpy(&header, slot, sizeof(RecordHeader));
+    if (payloadBuf != nullptr && header.payloadSize <= payloadBufSize) {
+        memcpy(payloadBuf, slot + sizeof(RecordHeader), header.payloadSize);
+    }
+    return true;
+}
+
+size_t EventTraceRecorder::getNumRecords() const {
+    return m_numRecords;
+}
+
+uint32_t EventTraceRecorder::getNumOverwrittenRecords() const {
+    return m_numOverwrittenRecords;
+}
+
+size_t EventTraceRecorder::getMaxPayloadSize() const {
+    return m_maxPayloadSize;
+}
+
+void EventTraceRecorder::setEnabled(bool isEnabled) {
+    m_isEnabled = isEnabled;
+}
+
+void EventTraceRecorder::clear() {
+    auto guard = m_lock.lockGuard();
+    m_head = 0;
+    m_numRecords = 0;
+    m_numOverwrittenRecords = 0;
+}
+
+uint8_t* EventTraceRecorder::getSlot(size_t slot) const {
+    return m_buffer + slot * m_slotSize;
+}
+
+} // namespace zct
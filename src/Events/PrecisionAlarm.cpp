@@ -0,0 +1,108 @@
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+#if defined(CONFIG_COUNTER)
+#include <zephyr/drivers/counter.h>
+#endif
+
+#include "ZephyrCppToolkit/Events/PrecisionAlarm.hpp"
+
+namespace zct {
+
+LOG_MODULE_REGISTER(zct_PrecisionAlarm, LOG_LEVEL_DBG);
+
+PrecisionAlarm::PrecisionAlarm() {}
+
+PrecisionAlarm::~PrecisionAlarm() {
+    cancel();
+}
+
+int PrecisionAlarm::configure(const struct device* counter, uint8_t channel, std::function<void()> callback) {
+    LOG_MODULE_DECLARE(zct_PrecisionAlarm, ZCT_PRECISION_ALARM_LOG_LEVEL);
+#if defined(CONFIG_COUNTER)
+    if (!device_is_ready(counter)) {
+        LOG_ERR("Counter device \"%s\" is not ready.", counter->name);
+        return -ENODEV;
+    }
+    if (channel >= counter_get_num_of_channels(counter)) {
+        LOG_ERR("Counter device \"%s\" does not have alarm channel %u.", counter->name, channel);
+        return -EINVAL;
+    }
+    int rc = counter_start(counter);
+    // Some counters are always running and return -EALREADY
+    if (rc != 0 && rc != -EALREADY) {
+        LOG_ERR("Failed to start counter device \"%s\". rc: %d.", counter->name, rc);
+        return rc;
+    }
+    uint32_t frequency_hz = counter_get_frequency(counter);
+    if (frequency_hz == 0) {
+        LOG_ERR("Counter device \"%s\" has no fixed frequency.", counter->name);
+        return -EINVAL;
+    }
+    m_counter = counter;
+    m_channel = channel;
+    m_frequency_hz = frequency_hz;
+    m_maxDelay_ticks = counter_get_top_value(counter);
+    // Can't overflow, the top value is 32 bits
+    m_maxDelay_ns = (static_cast<uint64_t>(m_maxDelay_ticks) * 1000000000ULL) / m_frequency_hz;
+    m_callback = callback;
+    return 0;
+#else
+    ARG_UNUSED(counter);
+    ARG_UNUSED(channel);
+    ARG_UNUSED(callback);
+    LOG_ERR("CONFIG_COUNTER must be enabled to use a precision alarm.");
+    return -ENOTSUP;
+#endif
+}
+
+bool PrecisionAlarm::isConfigured() const {
+    return m_counter != nullptr;
+}
+
+int PrecisionAlarm::arm(uint64_t delay_ns) {
+    __ASSERT(isConfigured(), "Precision alarm must be configured before it is armed.");
+#if defined(CONFIG_COUNTER)
+    cancel();
+    // Check the range first, otherwise delay_ns * m_frequency_hz could overflow and wrap round to a short delay
+    if (delay_ns > m_maxDelay_ns) {
+        return -ERANGE;
+    }
+    // Round up so the alarm never expires early. A relative alarm of 0 ticks is not allowed by all drivers.
+    uint64_t delay_ticks = (delay_ns * m_frequency_hz + 999999999ULL) / 1000000000ULL;
+    if (delay_ticks == 0) {
+        delay_ticks = 1;
+    }
+    struct counter_alarm_cfg alarmCfg = {};
+    alarmCfg.callback = staticAlarmCallback;
+    alarmCfg.ticks = static_cast<uint32_t>(delay_ticks);
+    alarmCfg.user_data = this;
+    alarmCfg.flags = 0;
+    return counter_set_channel_alarm(m_counter, m_channel, &alarmCfg);
+#else
+    ARG_UNUSED(delay_ns);
+    return -ENOTSUP;
+#endif
+}
+
+void PrecisionAlarm::cancel() {
+#if defined(CONFIG_COUNTER)
+    if (isConfigured()) {
+        // Cancelling an alarm which has already expired is harmless, so there is no need to track whether
+        // the alarm is armed (which would be shared with the ISR)
+        counter_cancel_channel_alarm(m_counter, m_channel);
+    }
+#endif
+}
+
+void PrecisionAlarm::staticAlarmCallback(const struct device* counter, uint8_t channel, uint32_t ticks, void* userData) {
+    ARG_UNUSED(counter);
+    ARG_UNUSED(channel);
+    ARG_UNUSED(ticks);
+    static_cast<PrecisionAlarm*>(userData)->m_callback();
+}
+
+} // namespace zct
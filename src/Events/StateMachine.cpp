@@ -0,0 +1,8 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+namespace zct {
+
+LOG_MODULE_REGISTER(zct_StateMachine, LOG_LEVEL_DBG);
+
+} // namespace zct
@@ -27,68 +27,244 @@ Timer::Timer(const char* name, std::function<void()> expiryCallback, TimerManage
     timerManager.registerTimer(*this);
 }
 
+Timer::~Timer() {
+    if (m_timerManager != nullptr) {
+        m_timerManager->unregisterTimer(*this);
+    }
+}
+
 void Timer::start(int64_t period_ms) {
     // Convert ms to ticks
     start(period_ms, period_ms);
 }
 
 void Timer::start(int64_t startDuration_ms, int64_t period_ms) {
-    LOG_MODULE_DECLARE(zct_Timer, ZCT_TIMER_LOG_LEVEL);
     __ASSERT_NO_MSG(startDuration_ms >= 0); // Start time can be 0, which means the timer will fire immediately. Can't be negative!
     __ASSERT_NO_MSG(period_ms >= -1); // Period can be -1, which means the timer will not repeat
-    
-    if (!this->m_isRegistered) {
-        LOG_WRN("Timer \"%s\" is not registered with a timer manager. Expiry events will not be handled.", this->m_name);
-    }
+    startNs(k_uptime_ticks(), startDuration_ms * 1000000, period_ms == -1 ? -1 : period_ms * 1000000);
+}
 
-    this->startTime_ticks = k_uptime_ticks();
-    // Use ceil and not floor to guarantee a minimum delay
-    this->nextExpiryTime_ticks = this->startTime_ticks + k_ms_to_ticks_ceil64(startDuration_ms);
-    if (period_ms == -1) {
-        this->period_ticks = -1;
+void Timer::start(k_timeout_t startDuration, k_timeout_t period) {
+    __ASSERT(startDuration.ticks >= 0, "Start duration must be a relative timeout."); // K_FOREVER and absolute timeouts are negative
+    if (K_TIMEOUT_EQ(period, K_FOREVER)) {
+        startTicks(startDuration.ticks, -1);
     } else {
-        this->period_ticks = k_ms_to_ticks_ceil64(period_ms);
+        __ASSERT(period.ticks >= 0, "Period must be a relative timeout or K_FOREVER.");
+        startTicks(startDuration.ticks, period.ticks);
+    }
+}
+
+void Timer::startTicks(int64_t startDuration_ticks, int64_t period_ticks) {
+    __ASSERT_NO_MSG(startDuration_ticks >= 0); // Start time can be 0, which means the timer will fire immediately. Can't be negative!
+    __ASSERT_NO_MSG(period_ticks >= -1); // Period can be -1, which means the timer will not repeat
+    startExact(k_uptime_ticks(), startDuration_ticks, 0, period_ticks, 0);
+}
+
+void Timer::startNs(int64_t startTime_ticks, int64_t startDuration_ns, int64_t period_ns) {
+    __ASSERT_NO_MSG(startDuration_ns >= 0); // Start time can be 0, which means the timer will fire immediately. Can't be negative!
+    __ASSERT_NO_MSG(period_ns >= -1); // Period can be -1, which means the timer will not repeat
+    int64_t startDuration_ticks;
+    uint32_t startDurationFraction;
+    nsToTicks(startDuration_ns, startDuration_ticks, startDurationFraction);
+    int64_t period_ticks = -1;
+    uint32_t periodFraction = 0;
+    if (period_ns != -1) {
+        nsToTicks(period_ns, period_ticks, periodFraction);
+    }
+    startExact(startTime_ticks, startDuration_ticks, startDurationFraction, period_ticks, periodFraction);
+}
+
+void Timer::startAtTicks(int64_t expiryTime_ticks, int64_t period_ticks) {
+    __ASSERT_NO_MSG(expiryTime_ticks >= 0);
+    __ASSERT_NO_MSG(period_ticks >= -1); // Period can be -1, which means the timer will not repeat
+    // An absolute expiry time is the same as a start duration of 0 measured from the expiry time
+    startExact(expiryTime_ticks, 0, 0, period_ticks, 0);
+}
+
+void Timer::startAligned(int64_t period_ms, int64_t phase_ms) {
+    startAlignedNs(period_ms * 1000000, phase_ms * 1000000);
+}
+
+void Timer::startAtNs(int64_t expiryTime_ns, int64_t period_ns) {
+    __ASSERT_NO_MSG(expiryTime_ns >= 0);
+    // Converting the expiry time from boot keeps any fraction of a tick, so timers started at the
+    // same absolute time expire on exactly the same tick
+    startNs(0, expiryTime_ns, period_ns);
+}
+
+void Timer::startAlignedNs(int64_t period_ns, int64_t phase_ns) {
+    __ASSERT(period_ns > 0, "Period of an aligned timer must be positive.");
+    __ASSERT_NO_MSG(phase_ns >= 0);
+    phase_ns %= period_ns;
+    // Find the first aligned time which is not before now
+    int64_t now_ns = static_cast<int64_t>(k_ticks_to_ns_floor64(k_uptime_ticks()));
+    int64_t elapsed_ns = now_ns - phase_ns;
+    int64_t numPeriods = elapsed_ns <= 0 ? 0 : (elapsed_ns + period_ns - 1) / period_ns;
+    startAtNs(phase_ns + numPeriods * period_ns, period_ns);
+}
+
+void Timer::startExact(int64_t startTime_ticks, int64_t startDuration_ticks, uint32_t startDurationFraction, int64_t period_ticks, uint32_t periodFraction) {
+    applyStart(startTime_ticks, startDuration_ticks, startDurationFraction, period_ticks, periodFraction);
+    notifyTimerManager();
+}
+
+void Timer::applyStart(int64_t startTime_ticks, int64_t startDuration_ticks, uint32_t startDurationFraction, int64_t period_ticks, uint32_t periodFraction) {
+    LOG_MODULE_DECLARE(zct_Timer, ZCT_TIMER_LOG_LEVEL);
+    if (m_timerManager == nullptr) {
+        LOG_WRN("Timer \"%s\" is not registered with a timer manager. Expiry events will not be handled.", this->m_name);
     }
-    this->m_isRunning = true;
+
+    this->startTime_ticks = startTime_ticks;
+    // Round up to the next whole tick and not down to guarantee a minimum delay. The fraction is remembered
+    // so that later expiries are calculated from the exact expiry time
+    m_expiryFraction = startDurationFraction;
+    nextExpiryTimeTicks() = this->startTime_ticks + startDuration_ticks + (startDurationFraction > 0 ? 1 : 0);
+    periodTicks() = period_ticks;
+    m_periodFraction = periodFraction;
 }
 
 void Timer::stop() {
-    this->m_isRunning = false;
-    this->period_ticks = -1;
+    applyStop();
+    notifyTimerManager();
+}
+
+void Timer::applyStop() {
+    periodTicks() = -1;
     this->startTime_ticks = 0;
-    this->nextExpiryTime_ticks = 0;
+    nextExpiryTimeTicks() = TimerManager::NOT_RUNNING_TICKS;
+}
+
+void Timer::startAsync(int64_t startDuration_ms, int64_t period_ms) {
+    __ASSERT_NO_MSG(startDuration_ms >= 0); // Start time can be 0, which means the timer will fire immediately. Can't be negative!
+    __ASSERT_NO_MSG(period_ms >= -1); // Period can be -1, which means the timer will not repeat
+    postCommand(Command::Start, startDuration_ms * 1000000, period_ms == -1 ? -1 : period_ms * 1000000);
+}
+
+void Timer::stopAsync() {
+    postCommand(Command::Stop, 0, -1);
+}
+
+void Timer::postCommand(Command command, int64_t startDuration_ns, int64_t period_ns) {
+    {
+        auto guard = m_pendingCommandLock.lockGuard();
+        m_pendingCommand = command;
+        // Remember when the command was posted so that the start duration is not stretched by however long the
+        // event thread takes to apply it
+        m_pendingCommandTime_ticks = k_uptime_ticks();
+        m_pendingStartDuration_ns = startDuration_ns;
+        m_pendingPeriod_ns = period_ns;
+    }
+
+    if (m_timerManager != nullptr) {
+        m_timerManager->onCommandPosted();
+    } else {
+        // Nothing else can be touching the timer's state if it is not registered
+        applyPendingCommand();
+    }
+}
+
+void Timer::applyPendingCommand() {
+    Command command;
+    int64_t commandTime_ticks;
+    int64_t startDuration_ns;
+    int64_t period_ns;
+    {
+        auto guard = m_pendingCommandLock.lockGuard();
+        command = m_pendingCommand;
+        commandTime_ticks = m_pendingCommandTime_ticks;
+        startDuration_ns = m_pendingStartDuration_ns;
+        period_ns = m_pendingPeriod_ns;
+        m_pendingCommand = Command::None;
+    }
+
+    if (command == Command::Start) {
+        startNs(commandTime_ticks, startDuration_ns, period_ns);
+    } else if (command == Command::Stop) {
+        stop();
+    }
 }
 
 bool Timer::isRunning() const { 
-    return this->m_isRunning; 
+    return nextExpiryTimeTicks() != TimerManager::NOT_RUNNING_TICKS;
 }
 
 void Timer::updateAfterExpiry() {
     LOG_MODULE_DECLARE(zct_Timer, ZCT_TIMER_LOG_LEVEL);
-    if (this->period_ticks == -1)
+    int64_t expiryTime_ticks = nextExpiryTimeTicks();
+    if (periodTicks() == -1)
     {
         // Timer was one-shot, so stop it
-        this->m_isRunning = false;
+        nextExpiryTimeTicks() = TimerManager::NOT_RUNNING_TICKS;
     }
     else
     {
         // Update expiry time based on the period
-        LOG_DBG("Updating timer expiry time. Period: %lld. Next expiry time before update: %lld.", this->period_ticks, this->nextExpiryTime_ticks);
-        this->nextExpiryTime_ticks += this->period_ticks;
-        LOG_DBG("Next expiry time after update: %lld.", this->nextExpiryTime_ticks);
+        LOG_DBG("Updating timer expiry time. Period: %lld. Next expiry time before update: %lld.", periodTicks(), nextExpiryTimeTicks());
+        // Add the fraction of a tick in the period to the exact expiry time. The stored expiry time is the exact expiry
+        // time rounded up to a whole tick, so undo the previous rounding and apply the new one.
+        int64_t roundingBefore_ticks = m_expiryFraction > 0 ? 1 : 0;
+        m_expiryFraction += m_periodFraction;
+        int64_t carry_ticks = 0;
+        if (m_expiryFraction >= TICK_FRACTION_DENOMINATOR) {
+            m_expiryFraction -= TICK_FRACTION_DENOMINATOR;
+            carry_ticks = 1;
+        }
+        int64_t roundingAfter_ticks = m_expiryFraction > 0 ? 1 : 0;
+        nextExpiryTimeTicks() += periodTicks() + carry_ticks - roundingBefore_ticks + roundingAfter_ticks;
+        LOG_DBG("Next expiry time after update: %lld.", nextExpiryTimeTicks());
+    }
+    if (m_isStatsEnabled) {
+        recordExpiryStats(expiryTime_ticks, k_uptime_ticks());
+    }
+    notifyTimerManager();
+}
+
+void Timer::recordExpiryStats(int64_t expiryTime_ticks, int64_t now_ticks) {
+    // Expiries are normally only handled once they are due, but don't let an early call make the stats go negative
+    int64_t lateness_ticks = now_ticks > expiryTime_ticks ? now_ticks - expiryTime_ticks : 0;
+    m_stats.numExpiries++;
+    if (lateness_ticks < m_stats.minLateness_ticks) {
+        m_stats.minLateness_ticks = lateness_ticks;
+    }
+    if (lateness_ticks > m_stats.maxLateness_ticks) {
+        m_stats.maxLateness_ticks = lateness_ticks;
+    }
+    m_stats.totalLateness_ticks += lateness_ticks;
+
+    // Bucket n holds [2^(n-1), 2^n) ticks, which is the number of bits needed to hold the lateness
+    uint32_t bucket = lateness_ticks == 0 ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(lateness_ticks));
+    if (bucket >= Stats::NUM_HISTOGRAM_BUCKETS) {
+        bucket = Stats::NUM_HISTOGRAM_BUCKETS - 1;
+    }
+    m_stats.latenessHistogram[bucket]++;
+
+    // If the next expiry is already due, the event loop is going to have to catch up
+    if (nextExpiryTimeTicks() <= now_ticks) {
+        m_stats.numCatchUpExpiries++;
     }
 }
 
 int64_t Timer::getNextExpiryTimeTicks() const { 
-    return this->nextExpiryTime_ticks; 
+    return nextExpiryTimeTicks();
 }
 
-void Timer::setIsRegistered(bool isRegistered) { 
-    this->m_isRegistered = isRegistered; 
+int64_t Timer::getNextExpiryTimeNs() const {
+    int64_t nextExpiryTime_ticks = nextExpiryTimeTicks();
+    if (nextExpiryTime_ticks == TimerManager::NOT_RUNNING_TICKS) {
+        return INT64_MAX;
+    }
+    if (m_expiryFraction == 0) {
+        return static_cast<int64_t>(k_ticks_to_ns_floor64(nextExpiryTime_ticks));
+    }
+    // The expiry time was rounded up to the next tick, so the exact time is the fraction of a tick after the previous one.
+    // A fraction of TICK_FRACTION_DENOMINATOR is one tick, which is 1e9 / CONFIG_SYS_CLOCK_TICKS_PER_SEC ns.
+    // Round up so that we never expire early.
+    return static_cast<int64_t>(k_ticks_to_ns_floor64(nextExpiryTime_ticks - 1))
+        + (m_expiryFraction + CONFIG_SYS_CLOCK_TICKS_PER_SEC - 1) / CONFIG_SYS_CLOCK_TICKS_PER_SEC;
 }
 
 bool Timer::getIsRegistered() const { 
-    return this->m_isRegistered; 
+    return m_timerManager != nullptr; 
 }
 
 void Timer::setExpiryCallback(std::function<void()> callback) { 
@@ -99,4 +275,76 @@ const std::function<void()>& Timer::getExpiryCallback() const {
     return m_expiryCallback; 
 }
 
+void Timer::setStatsEnabled(bool isEnabled) {
+    m_isStatsEnabled = isEnabled;
+}
+
+bool Timer::getStatsEnabled() const {
+    return m_isStatsEnabled;
+}
+
+const Timer::Stats& Timer::getStats() const {
+    return m_stats;
+}
+
+void Timer::resetStats() {
+    m_stats = Stats();
+}
+
+const char* Timer::getName() const {
+    return m_name;
+}
+
+void Timer::setTimerManager(TimerManager* timerManager, uint32_t slot) {
+    __ASSERT(m_timerManager == nullptr, "Timer \"%s\" is already registered with a timer manager.", m_name);
+    // Move the expiry time and period into the timer manager, in case the timer was started before it was registered
+    timerManager->m_nextExpiryTimes_ticks[slot] = m_unregisteredNextExpiryTime_ticks;
+    timerManager->m_periods_ticks[slot] = m_unregisteredPeriod_ticks;
+    m_timerManager = timerManager;
+    m_slot = slot;
+}
+
+void Timer::clearTimerManager() {
+    __ASSERT_NO_MSG(m_timerManager != nullptr);
+    m_unregisteredNextExpiryTime_ticks = m_timerManager->m_nextExpiryTimes_ticks[m_slot];
+    m_unregisteredPeriod_ticks = m_timerManager->m_periods_ticks[m_slot];
+    m_timerManager = nullptr;
+    m_slot = 0;
+}
+
+void Timer::notifyTimerManager() {
+    if (m_timerManager != nullptr) {
+        m_timerManager->onTimerChanged(*this);
+    }
+}
+
+void Timer::nsToTicks(int64_t duration_ns, int64_t& ticks, uint32_t& fraction) {
+    // Split into whole seconds first so that the multiplication by the tick rate cannot overflow
+    int64_t seconds = duration_ns / TICK_FRACTION_DENOMINATOR;
+    uint64_t remainderScaled = static_cast<uint64_t>(duration_ns % TICK_FRACTION_DENOMINATOR) * CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+    ticks = seconds * CONFIG_SYS_CLOCK_TICKS_PER_SEC + static_cast<int64_t>(remainderScaled / TICK_FRACTION_DENOMINATOR);
+    fraction = static_cast<uint32_t>(remainderScaled % TICK_FRACTION_DENOMINATOR);
+}
+
+int64_t& Timer::nextExpiryTimeTicks() {
+    if (m_timerManager != nullptr) {
+        return m_timerManager->m_nextExpiryTimes_ticks[m_slot];
+    }
+    return m_unregisteredNextExpiryTime_ticks;
+}
+
+const int64_t& Timer::nextExpiryTimeTicks() const {
+    if (m_timerManager != nullptr) {
+        return m_timerManager->m_nextExpiryTimes_ticks[m_slot];
+    }
+    return m_unregisteredNextExpiryTime_ticks;
+}
+
+int64_t& Timer::periodTicks() {
+    if (m_timerManager != nullptr) {
+        return m_timerManager->m_periods_ticks[m_slot];
+    }
+    return m_unregisteredPeriod_ticks;
+}
+
 } // namespace zct
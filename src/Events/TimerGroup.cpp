@@ -0,0 +1,94 @@
+//================================================================================================//
+// INCLUDES
+//================================================================================================//
+
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+
+#include "ZephyrCppToolkit/Events/TimerGroup.hpp"
+
+namespace zct {
+
+TimerGroup::TimerGroup(uint32_t maxNumTimers, Arena* arena) :
+    m_maxNumTimers(maxNumTimers),
+    m_arena(Arena::resolve(arena))
+{
+    m_timers = Arena::newArray<Timer*>(m_arena, maxNumTimers);
+    __ASSERT_NO_MSG(m_timers != nullptr);
+}
+
+TimerGroup::TimerGroup(Timer** timers, uint32_t maxNumTimers) :
+    m_timers(timers),
+    m_maxNumTimers(maxNumTimers),
+    m_arena(nullptr),
+    m_isStorageOwned(false)
+{
+}
+
+TimerGroup::~TimerGroup() {
+    // Free the memory allocated in constructor.
+    if (m_isStorageOwned) {
+        Arena::deleteArray(m_arena, m_timers, m_maxNumTimers);
+    }
+}
+
+void TimerGroup::add(Timer& timer) {
+    __ASSERT(m_numTimers < m_maxNumTimers, "Max number of timers of %u reached.", m_maxNumTimers);
+    __ASSERT(timer.m_timerManager != nullptr, "Timer \"%s\" must be registered with a timer manager before it is added to a group.", timer.getName());
+    __ASSERT(m_timerManager == nullptr || m_timerManager == timer.m_timerManager,
+        "All timers in a group must be registered with the same timer manager.");
+    m_timerManager = timer.m_timerManager;
+    m_timers[m_numTimers] = &timer;
+    m_numTimers++;
+}
+
+void TimerGroup::startAll(int64_t startDuration_ms, int64_t period_ms) {
+    __ASSERT_NO_MSG(startDuration_ms >= 0); // Start time can be 0, which means the timers will fire immediately. Can't be negative!
+    __ASSERT_NO_MSG(period_ms >= -1); // Period can be -1, which means the timers will not repeat
+    // Convert once, and use the same start time for every timer so they stay in step
+    int64_t startDuration_ticks;
+    uint32_t startDurationFraction;
+    Timer::nsToTicks(startDuration_ms * 1000000, startDuration_ticks, startDurationFraction);
+    int64_t period_ticks = -1;
+    uint32_t periodFraction = 0;
+    if (period_ms != -1) {
+        Timer::nsToTicks(period_ms * 1000000, period_ticks, periodFraction);
+    }
+    int64_t startTime_ticks = k_uptime_ticks();
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        m_timers[i]->applyStart(startTime_ticks, startDuration_ticks, startDurationFraction, period_ticks, periodFraction);
+    }
+    notifyTimerManager();
+}
+
+void TimerGroup::stopAll() {
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        m_timers[i]->applyStop();
+    }
+    notifyTimerManager();
+}
+
+void TimerGroup::shiftAll(int64_t delta_ms) {
+    // Round towards later so that no timer expires early
+    int64_t delta_ticks = delta_ms >= 0
+        ? static_cast<int64_t>(k_ms_to_ticks_ceil64(delta_ms))
+        : -static_cast<int64_t>(k_ms_to_ticks_floor64(-delta_ms));
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        if (m_timers[i]->isRunning()) {
+            m_timers[i]->nextExpiryTimeTicks() += delta_ticks;
+        }
+    }
+    notifyTimerManager();
+}
+
+uint32_t TimerGroup::getNumTimers() const {
+    return m_numTimers;
+}
+
+void TimerGroup::notifyTimerManager() {
+    if (m_timerManager != nullptr) {
+        m_timerManager->onTimersChanged(m_timers, m_numTimers);
+    }
+}
+
+} // namespace zct
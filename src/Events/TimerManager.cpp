@@ -7,6 +7,8 @@
 // INCLUDES
 //================================================================================================//
 
+#include <string.h>
+
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
 
@@ -17,65 +19,188 @@ namespace zct {
 
 LOG_MODULE_REGISTER(TimerManager, LOG_LEVEL_DBG);
 
-TimerManager::TimerManager(uint32_t maxNumTimers) {
+TimerManager::TimerManager(uint32_t maxNumTimers, Arena* arena) :
+    m_arena(Arena::resolve(arena))
+{
     LOG_MODULE_DECLARE(TimerManager, ZCT_TIMER_MANAGER_LOG_LEVEL);
     LOG_DBG("TimerManager constructor called.");
-    m_timers = new Timer*[maxNumTimers];
+    m_timers = Arena::newArray<Timer*>(m_arena, maxNumTimers);
+    m_nextExpiryTimes_ticks = Arena::newArray<int64_t>(m_arena, maxNumTimers);
+    m_periods_ticks = Arena::newArray<int64_t>(m_arena, maxNumTimers);
+    __ASSERT_NO_MSG(m_timers != nullptr && m_nextExpiryTimes_ticks != nullptr && m_periods_ticks != nullptr);
     for (uint32_t i = 0; i < maxNumTimers; i++) {
         m_timers[i] = nullptr;
+        m_nextExpiryTimes_ticks[i] = NOT_RUNNING_TICKS;
+        m_periods_ticks[i] = -1;
     }
     m_maxNumTimers = maxNumTimers;
     LOG_DBG("TimerManager constructor finished.");
 }
 
 TimerManager::~TimerManager() {
+    // Any timers which outlive us must not point to the arrays below
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        m_timers[i]->clearTimerManager();
+    }
     // Free the memory allocated in constructor.
-    delete[] m_timers;
+    Arena::deleteArray(m_arena, m_timers, m_maxNumTimers);
+    Arena::deleteArray(m_arena, m_nextExpiryTimes_ticks, m_maxNumTimers);
+    Arena::deleteArray(m_arena, m_periods_ticks, m_maxNumTimers);
 }
 
 void TimerManager::registerTimer(Timer& timer) {
     __ASSERT(m_numTimers < m_maxNumTimers, "Max number of timers of %u reached.", m_maxNumTimers);
-    m_timers[m_numTimers] = &timer;
+    uint32_t slot = m_numTimers;
+    m_timers[slot] = &timer;
     m_numTimers++;
-    // Make sure to set the isRegistered flag to true. This will prevent log warnings
-    // if the timer is started when it is not registered with any timer managers.
-    timer.setIsRegistered(true);
+    // Moves the timer's expiry time and period into the slot
+    timer.setTimerManager(this, slot);
+    // The timer may have been started before it was registered
+    m_isNextExpiringTimerValid = false;
+    m_changeCount++;
+}
+
+void TimerManager::unregisterTimer(Timer& timer) {
+    __ASSERT(timer.m_timerManager == this, "Timer \"%s\" is not registered with this timer manager.", timer.getName());
+    uint32_t slot = timer.m_slot;
+    timer.clearTimerManager();
+    // Keep the slots contiguous for findEarliestSlot() by moving the last timer into the freed slot
+    uint32_t lastSlot = m_numTimers - 1;
+    if (slot != lastSlot) {
+        m_timers[slot] = m_timers[lastSlot];
+        m_nextExpiryTimes_ticks[slot] = m_nextExpiryTimes_ticks[lastSlot];
+        m_periods_ticks[slot] = m_periods_ticks[lastSlot];
+        m_timers[slot]->m_slot = slot;
+    }
+    m_timers[lastSlot] = nullptr;
+    m_nextExpiryTimes_ticks[lastSlot] = NOT_RUNNING_TICKS;
+    m_periods_ticks[lastSlot] = -1;
+    m_numTimers--;
+    // The cached slot may have been removed or moved
+    m_isNextExpiringTimerValid = false;
+    m_changeCount++;
+}
+
+void TimerManager::onTimerChanged(Timer& timer) {
+    m_changeCount++;
+    if (!m_isNextExpiringTimerValid) {
+        // Already going to rescan
+        return;
+    }
+    int32_t slot = static_cast<int32_t>(timer.m_slot);
+    if (slot == m_nextExpiringSlot) {
+        // The earliest timer has been stopped or moved, some other timer might be the earliest now
+        m_isNextExpiringTimerValid = false;
+    } else if (m_nextExpiryTimes_ticks[slot] != NOT_RUNNING_TICKS
+               && (m_nextExpiringSlot == -1 || isEarlier(slot, m_nextExpiringSlot))) {
+        // Timer now expires before the cached one, so it becomes the earliest without a rescan
+        m_nextExpiringSlot = slot;
+    }
+    // Otherwise a timer that was not the earliest has changed but still expires after the earliest one. Nothing to do.
+}
+
+void TimerManager::onTimersChanged(Timer* const* timers, uint32_t numTimers) {
+    m_changeCount++;
+    if (!m_isNextExpiringTimerValid) {
+        // Already going to rescan
+        return;
+    }
+    // The timers that did not change still expire no earlier than the cached timer, so the earliest timer is either
+    // the cached one or one of the changed ones. Unless the cached one has changed, in which case we have to rescan.
+    int32_t earliestSlot = m_nextExpiringSlot;
+    for (uint32_t i = 0; i < numTimers; i++) {
+        int32_t slot = static_cast<int32_t>(timers[i]->m_slot);
+        if (slot == m_nextExpiringSlot) {
+            m_isNextExpiringTimerValid = false;
+            return;
+        }
+        if (m_nextExpiryTimes_ticks[slot] != NOT_RUNNING_TICKS && (earliestSlot == -1 || isEarlier(slot, earliestSlot))) {
+            earliestSlot = slot;
+        }
+    }
+    m_nextExpiringSlot = earliestSlot;
+}
+
+void TimerManager::setSubTickPrecision(bool isEnabled) {
+    m_isSubTickPrecision = isEnabled;
+    // Timers on the same tick may now be ordered differently
+    m_isNextExpiringTimerValid = false;
+}
+
+void TimerManager::setWakeCallback(std::function<void()> wakeCallback) {
+    m_wakeCallback = wakeCallback;
+}
+
+void TimerManager::onCommandPosted() {
+    // Only wake the owning thread on the first command. It applies all pending commands in one go,
+    // so waking it again for every command would just fill up its queue
+    if (atomic_set(&m_hasPendingCommands, 1) == 0 && m_wakeCallback) {
+        m_wakeCallback();
+    }
+}
+
+bool TimerManager::hasPendingCommands() const {
+    return atomic_get(&m_hasPendingCommands) != 0;
+}
+
+uint32_t TimerManager::getChangeCount() const {
+    return m_changeCount;
 }
 
 TimerManager::TimerExpiryInfo TimerManager::getNextExpiringTimer() {
     LOG_MODULE_DECLARE(TimerManager, ZCT_TIMER_MANAGER_LOG_LEVEL);
     LOG_DBG("getNextExpiringTimer() called. this: %p, m_numTimers: %u.", this, m_numTimers);
 
-    // Set output to null in case no timer expired
-    Timer* expiredTimer = nullptr;
-    uint64_t durationToWaitUs = 0;
-    // Iterate through all registered timers, and find the one that is expiring next (if any)
-    for(uint32_t i = 0; i < this->m_numTimers; i++) {
-        Timer* timer = this->m_timers[i];
-        if (timer->isRunning()) {
-            if (expiredTimer == nullptr || timer->getNextExpiryTimeTicks() < expiredTimer->getNextExpiryTimeTicks()) {
-                // LOG_DBG("Setting expired timer to %p.", timer);
-                expiredTimer = timer;
-            }
+    // Apply any commands posted from other threads or ISRs first. The flag is cleared before the commands are applied,
+    // so a command posted while we are applying them sets it again and is picked up next time
+    if (atomic_clear(&m_hasPendingCommands) != 0) {
+        for (uint32_t i = 0; i < m_numTimers; i++) {
+            m_timers[i]->applyPendingCommand();
         }
     }
+
+    // Only rescan the timers if something has happened which could mean the cached timer is no longer the earliest.
+    // This keeps the cost per event loop iteration O(1) when no timers have changed.
+    if (!m_isNextExpiringTimerValid) {
+        m_nextExpiringSlot = findEarliestSlot();
+        m_isNextExpiringTimerValid = true;
+    }
+    Timer* expiredTimer = nullptr;
+    int64_t nextExpiryTime_ticks = 0;
+    if (m_nextExpiringSlot != -1) {
+        expiredTimer = m_timers[m_nextExpiringSlot];
+        nextExpiryTime_ticks = m_nextExpiryTimes_ticks[m_nextExpiringSlot];
+    }
+    uint64_t durationToWaitUs = 0;
     LOG_DBG("Expired timer: %p.\n", expiredTimer);
 
     // Convert the expiry time to a duration from now
     // Calculate time to wait for next timeout event
     durationToWaitUs = 0;
 
+    if (expiredTimer != nullptr && m_isSubTickPrecision) {
+        // Compare the exact expiry time with the cycle counter rather than waiting for the tick
+        int64_t nextExpiryTime_ns = expiredTimer->getNextExpiryTimeNs();
+        int64_t uptime_ns = getPreciseUptimeNs();
+        if (nextExpiryTime_ns > uptime_ns) {
+            // Round up so that we never wake early
+            durationToWaitUs = static_cast<uint64_t>(nextExpiryTime_ns - uptime_ns + 999) / 1000;
+        }
+        LOG_DBG("Time to wait in us: %llu.", durationToWaitUs);
+        return TimerManager::TimerExpiryInfo{expiredTimer, durationToWaitUs};
+    }
+
     // Ticks is the fundemental resolution that the kernel does operations at
     int64_t uptime_ticks = k_uptime_ticks();
     if (expiredTimer != nullptr) {
-        if (expiredTimer->getNextExpiryTimeTicks() <= uptime_ticks) {
+        if (nextExpiryTime_ticks <= uptime_ticks) {
             durationToWaitUs = 0;
             LOG_DBG("Timer expired.");
             // Need to update the timer now that we have detected it has expired.
             // This will either stop the timer if it is a one-shot, or update the next expiry time
             // expiredTimer->updateAfterExpiry();
         } else {
-            durationToWaitUs = k_ticks_to_us_ceil64(expiredTimer->getNextExpiryTimeTicks() - uptime_ticks);
+            durationToWaitUs = k_ticks_to_us_ceil64(nextExpiryTime_ticks - uptime_ticks);
             LOG_DBG("Time to wait in us: %llu.", durationToWaitUs);
         }
     }
@@ -87,4 +212,76 @@ TimerManager::TimerExpiryInfo TimerManager::getNextExpiringTimer() {
     return TimerManager::TimerExpiryInfo{expiredTimer, durationToWaitUs};
 }
 
+void TimerManager::logStats(const char* name) const {
+    // The user has asked for the stats, so log them even if the timer manager log level is higher
+    LOG_MODULE_DECLARE(TimerManager, LOG_LEVEL_INF);
+    static_assert(Timer::Stats::NUM_HISTOGRAM_BUCKETS == 8, "Update the histogram in the log message below.");
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        const Timer& timer = *m_timers[i];
+        if (!timer.getStatsEnabled() || (name != nullptr && strcmp(name, timer.getName()) != 0)) {
+            continue;
+        }
+        const Timer::Stats& stats = timer.getStats();
+        if (stats.numExpiries == 0) {
+            LOG_INF("Timer \"%s\": no expiries.", timer.getName());
+            continue;
+        }
+        const uint32_t* hist = stats.latenessHistogram;
+        LOG_INF("Timer \"%s\": %u expiries (%u catch-up), lateness min/mean/max %llu/%llu/%llu us, histogram [%u %u %u %u %u %u %u %u].",
+            timer.getName(), stats.numExpiries, stats.numCatchUpExpiries,
+            (unsigned long long)k_ticks_to_us_floor64(stats.minLateness_ticks),
+            (unsigned long long)k_ticks_to_us_floor64(stats.getMeanLateness_ticks()),
+            (unsigned long long)k_ticks_to_us_floor64(stats.maxLateness_ticks),
+            hist[0], hist[1], hist[2], hist[3], hist[4], hist[5], hist[6], hist[7]);
+    }
+}
+
+int32_t TimerManager::findEarliestSlot() const {
+    // First find the earliest expiry time. Stopped timers hold NOT_RUNNING_TICKS so they never win, which keeps
+    // this a branch-free min-reduction over a contiguous array that the compiler can vectorise.
+    int64_t earliest_ticks = NOT_RUNNING_TICKS;
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        earliest_ticks = m_nextExpiryTimes_ticks[i] < earliest_ticks ? m_nextExpiryTimes_ticks[i] : earliest_ticks;
+    }
+    if (earliest_ticks == NOT_RUNNING_TICKS) {
+        return -1;
+    }
+    // Then find the first timer with that expiry time
+    int32_t earliestSlot = -1;
+    for (uint32_t i = 0; i < m_numTimers; i++) {
+        if (m_nextExpiryTimes_ticks[i] == earliest_ticks) {
+            if (!m_isSubTickPrecision) {
+                return static_cast<int32_t>(i);
+            }
+            // Several timers may expire on the same tick, pick the one with the earliest exact expiry time
+            if (earliestSlot == -1 || isEarlier(i, static_cast<uint32_t>(earliestSlot))) {
+                earliestSlot = static_cast<int32_t>(i);
+            }
+        }
+    }
+    return earliestSlot;
+}
+
+bool TimerManager::isEarlier(uint32_t slotA, uint32_t slotB) const {
+    if (m_nextExpiryTimes_ticks[slotA] != m_nextExpiryTimes_ticks[slotB] || !m_isSubTickPrecision) {
+        return m_nextExpiryTimes_ticks[slotA] < m_nextExpiryTimes_ticks[slotB];
+    }
+    // Both expire on the same tick. A timer with no fraction expires exactly on the tick, which is after
+    // any timer that has been rounded up to it.
+    uint32_t fractionA = m_timers[slotA]->m_expiryFraction;
+    uint32_t fractionB = m_timers[slotB]->m_expiryFraction;
+    fractionA = fractionA == 0 ? Timer::TICK_FRACTION_DENOMINATOR : fractionA;
+    fractionB = fractionB == 0 ? Timer::TICK_FRACTION_DENOMINATOR : fractionB;
+    return fractionA < fractionB;
+}
+
+int64_t TimerManager::getPreciseUptimeNs() {
+#if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+    return static_cast<int64_t>(k_cyc_to_ns_floor64(k_cycle_get_64()));
+#else
+    // A 32-bit cycle counter wraps too quickly to be used as an uptime
+    return static_cast<int64_t>(k_ticks_to_ns_floor64(k_uptime_ticks()));
+#endif
+}
+
 } // namespace zct
@@ -56,15 +56,15 @@ int WatchdogMock::installTimeout(uint32_t timeoutMs,
         .lastFed = std::chrono::steady_clock::now()
     };
     
-    int channelId = m_nextChannelId++;
-    
-    // Ensure vectors are large enough
-    if (static_cast<size_t>(channelId) >= m_channels.size()) {
-        m_channels.resize(channelId + 1);
-        m_feedCounts.resize(channelId + 1, 0);
+    if (m_channels.full()) {
+        LOG_ERR("WatchdogMock '%s': No free channels (max %zu).", m_name, MAX_NUM_CHANNELS);
+        return -ENOMEM;
     }
     
-    m_channels[channelId] = channel;
+    // Channel IDs are assigned in order, so they double as indexes
+    int channelId = m_nextChannelId++;
+    m_channels.push_back(channel);
+    m_feedCounts.push_back(0);
     
     LOG_DBG("WatchdogMock '%s': Timeout installed successfully, channel ID: %d.", m_name, channelId);
     return channelId;
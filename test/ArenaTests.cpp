@@ -0,0 +1,69 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/Arena.hpp"
+#include "ZephyrCppToolkit/Events/TimerManager.hpp"
+
+ZTEST_SUITE(ArenaTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(ArenaTests, testAllocate)
+{
+    zct::StaticArena<256> arena("test");
+    zassert_equal(arena.getSize_bytes(), 256);
+    zassert_equal(arena.getUsed_bytes(), 0);
+
+    void* block1 = arena.allocate(3, 1);
+    void* block2 = arena.allocate(8, 8);
+    zassert_not_null(block1);
+    zassert_not_null(block2);
+    zassert_equal(reinterpret_cast<uintptr_t>(block2) % 8, 0, "Block should be aligned.");
+    zassert_true(static_cast<uint8_t*>(block2) >= static_cast<uint8_t*>(block1) + 3, "Blocks should not overlap.");
+    zassert_equal(arena.getNumAllocations(), 2);
+    zassert_true(arena.getUsed_bytes() >= 11 && arena.getUsed_bytes() <= 16);
+
+    zassert_false(arena.isFrozen());
+    arena.freeze();
+    zassert_true(arena.isFrozen());
+}
+
+ZTEST(ArenaTests, testNewArray)
+{
+    zct::StaticArena<256> arena;
+
+    int64_t* items = zct::Arena::newArray<int64_t>(&arena, 4);
+    zassert_not_null(items);
+    zassert_equal(reinterpret_cast<uintptr_t>(items) % alignof(int64_t), 0);
+    zassert_equal(arena.getUsed_bytes(), 4 * sizeof(int64_t));
+    zct::Arena::deleteArray(&arena, items, 4);
+
+    // Arena memory is not reused
+    zassert_equal(arena.getUsed_bytes(), 4 * sizeof(int64_t));
+
+    // No arena means the heap
+    int64_t* heapItems = zct::Arena::newArray<int64_t>(nullptr, 4);
+    zassert_not_null(heapItems);
+    zct::Arena::deleteArray<int64_t>(nullptr, heapItems, 4);
+}
+
+ZTEST(ArenaTests, testDefaultArenaUsedByToolkit)
+{
+    static zct::StaticArena<1024> arena("toolkit");
+    zassert_is_null(zct::Arena::getDefault());
+    zct::Arena::setDefault(&arena);
+
+    {
+        zct::TimerManager timerManager(4);
+        zassert_true(arena.getUsed_bytes() >= 4 * (sizeof(void*) + 2 * sizeof(int64_t)),
+                     "Timer manager should have allocated from the default arena.");
+    }
+
+    // An arena passed in directly takes precedence over the default
+    zct::StaticArena<1024> otherArena;
+    size_t used_bytes = arena.getUsed_bytes();
+    {
+        zct::TimerManager timerManager(4, &otherArena);
+    }
+    zassert_equal(arena.getUsed_bytes(), used_bytes);
+    zassert_true(otherArena.getUsed_bytes() > 0);
+
+    zct::Arena::setDefault(nullptr);
+}
@@ -0,0 +1,131 @@
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/CalendarScheduler.hpp"
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(CalendarSchedulerTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(CalendarSchedulerTests, NULL, NULL, NULL, NULL, NULL);
+
+using Rule = zct::CalendarScheduler::Rule;
+
+/** 2024-01-01 00:00:00 UTC, a Monday. */
+constexpr int64_t NEW_YEAR_2024_S = 1704067200;
+
+namespace MyEvents {
+    struct ExitEvent {};
+    using Generic = std::variant<ExitEvent>;
+} // namespace MyEvents
+
+class CalendarTestClass {
+public:
+    CalendarTestClass() :
+        m_eventThread(
+            "CalendarTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_scheduler(m_eventThread.timerManager(), 2)
+    {
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+        m_eventThread.start();
+    }
+
+    ~CalendarTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::CalendarScheduler m_scheduler;
+    atomic_t m_count = ATOMIC_INIT(0);
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(CalendarSchedulerTests, testFindNextDueTime)
+{
+    // Daily at 03:00
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(Rule::daily(3, 0), NEW_YEAR_2024_S), NEW_YEAR_2024_S + 3 * 3600);
+    // Due times are always after the search time
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(Rule::daily(0, 0), NEW_YEAR_2024_S), NEW_YEAR_2024_S + 24 * 3600);
+    // Every hour on the hour, from part way through an hour
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(Rule::hourly(0), NEW_YEAR_2024_S + 1234), NEW_YEAR_2024_S + 3600);
+    // Saturday 12:30 is 5 days after Monday
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(Rule::weekly(zct::CalendarScheduler::SATURDAY, 12, 30), NEW_YEAR_2024_S),
+        NEW_YEAR_2024_S + 5 * 24 * 3600 + 12 * 3600 + 30 * 60);
+
+    // The 31st of February never happens
+    Rule rule;
+    rule.months = 1 << 2;
+    rule.daysOfMonth = 1UL << 31;
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(rule, NEW_YEAR_2024_S), -1);
+}
+
+ZTEST(CalendarSchedulerTests, testLeapDayOnMonday)
+{
+    // The 29th of February on a Monday, which can take up to 40 years to come round
+    Rule rule = Rule::weekly(zct::CalendarScheduler::MONDAY, 0, 0);
+    rule.months = 1 << 2;
+    rule.daysOfMonth = 1UL << 29;
+
+    // 1988-02-29 is 6633 days after the epoch
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(rule, 0), 6633LL * 24 * 3600);
+    // 2044-02-29 is 27087 days after the epoch
+    zassert_equal(zct::CalendarScheduler::findNextDueTime(rule, NEW_YEAR_2024_S), 27087LL * 24 * 3600);
+
+    // The rule is valid, so it can be added
+    zct::TimerManager timerManager(1);
+    zct::StaticCalendarScheduler<1> scheduler(timerManager);
+    zassert_true(scheduler.addRule(rule, []() {}) >= 0, "Failed to add a valid rule.");
+}
+
+ZTEST(CalendarSchedulerTests, testRuleIsCalledAndRescheduledOnTimeChange)
+{
+    CalendarTestClass testObj;
+    int ruleId = -1;
+    testObj.m_eventThread.runInLoop([&testObj, &ruleId]() {
+        ruleId = testObj.m_scheduler.addRule(Rule::everyMinute(), [&testObj]() { atomic_inc(&testObj.m_count); });
+        // Nothing is scheduled until the time is set
+        testObj.m_scheduler.setTime(NEW_YEAR_2024_S * 1000 - 50);
+    });
+    k_sleep(K_MSEC(100));
+    zassert_true(ruleId >= 0, "Failed to add rule. rc: %d.", ruleId);
+    zassert_equal(atomic_get(&testObj.m_count), 1, "Rule should have been called once.");
+
+    // Moving the time backwards should make the rule due again
+    testObj.m_eventThread.runInLoop([&testObj]() {
+        testObj.m_scheduler.setTime(NEW_YEAR_2024_S * 1000 - 50);
+    });
+    k_sleep(K_MSEC(100));
+    zassert_equal(atomic_get(&testObj.m_count), 2, "Rule should have been called again after the time was corrected.");
+}
+
+ZTEST(CalendarSchedulerTests, testStaticSchedulerRuleLimit)
+{
+    zct::TimerManager timerManager(1);
+    zct::StaticCalendarScheduler<2> scheduler(timerManager);
+    int ruleId1 = scheduler.addRule(Rule::daily(3, 0), []() {});
+    int ruleId2 = scheduler.addRule(Rule::hourly(0), []() {});
+    zassert_true(ruleId1 >= 0 && ruleId2 >= 0 && ruleId1 != ruleId2);
+    zassert_equal(scheduler.addRule(Rule::everyMinute(), []() {}), -ENOMEM, "Only two rules fit.");
+
+    // Removing a rule frees its slot
+    scheduler.removeRule(ruleId1);
+    zassert_true(scheduler.addRule(Rule::everyMinute(), []() {}) >= 0);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/DoubleBuffer.hpp"
+
+ZTEST_SUITE(DoubleBufferTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace {
+
+struct Frame {
+    uint32_t id;
+    uint16_t samples[64];
+};
+
+} // namespace
+
+ZTEST(DoubleBufferTests, testPingPong)
+{
+    zct::DoubleBuffer<Frame, 32> doubleBuffer;
+
+    Frame* fillBuffer = doubleBuffer.getFillBuffer();
+    zassert_equal(reinterpret_cast<uintptr_t>(fillBuffer) % 32, 0, "Buffers should be aligned.");
+    zassert_is_null(doubleBuffer.acquire(), "Nothing has been filled yet.");
+
+    fillBuffer->id = 1;
+    Frame* nextFillBuffer = doubleBuffer.swap();
+    zassert_not_equal(nextFillBuffer, fillBuffer);
+    zassert_equal(reinterpret_cast<uintptr_t>(nextFillBuffer) % 32, 0, "Buffers should be aligned.");
+
+    const Frame* frame = doubleBuffer.acquire();
+    zassert_equal(frame, fillBuffer);
+    zassert_equal(frame->id, 1);
+    doubleBuffer.release();
+
+    // Only handed out once
+    zassert_is_null(doubleBuffer.acquire());
+}
+
+ZTEST(DoubleBufferTests, testOverrunWhileConsumerBusy)
+{
+    zct::DoubleBuffer<Frame> doubleBuffer;
+
+    doubleBuffer.getFillBuffer()->id = 1;
+    Frame* fillBuffer = doubleBuffer.swap();
+    const Frame* frame = doubleBuffer.acquire();
+    zassert_not_null(frame);
+
+    // The consumer still has frame 1, so the producer has to refill the same buffer
+    fillBuffer->id = 2;
+    zassert_equal(doubleBuffer.swap(), fillBuffer);
+    zassert_equal(doubleBuffer.getNumOverruns(), 1);
+    zassert_equal(frame->id, 1);
+    doubleBuffer.release();
+
+    // Now the swap goes through
+    fillBuffer->id = 3;
+    zassert_not_equal(doubleBuffer.swap(), fillBuffer);
+    frame = doubleBuffer.acquire();
+    zassert_equal(frame->id, 3);
+    doubleBuffer.release();
+}
+
+ZTEST(DoubleBufferTests, testUnprocessedFrameIsReplaced)
+{
+    zct::DoubleBuffer<Frame> doubleBuffer;
+
+    doubleBuffer.getFillBuffer()->id = 1;
+    doubleBuffer.swap()->id = 2;
+    doubleBuffer.swap();
+
+    // The consumer didn't pick up frame 1 in time, so it gets frame 2 without an overrun
+    const Frame* frame = doubleBuffer.acquire();
+    zassert_equal(frame->id, 2);
+    zassert_equal(doubleBuffer.getNumOverruns(), 0);
+    doubleBuffer.release();
+}
@@ -0,0 +1,117 @@
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(EventThreadBudgetTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(EventThreadBudgetTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    struct SlowEvent {
+        uint32_t busyTimeUs;
+    };
+    struct StartTimerEvent {
+        uint32_t durationMs;
+    };
+    using Generic = std::variant<ExitEvent, SlowEvent, StartTimerEvent>;
+} // namespace MyEvents
+
+class BudgetTestClass {
+public:
+    BudgetTestClass(uint32_t budgetUs) :
+        m_eventThread(
+            "BudgetTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_timer("BudgetTimer", [this]() {
+            atomic_set(&m_eventCountAtTimer, atomic_get(&m_eventCount));
+            atomic_inc(&m_timerCount);
+        }, m_eventThread.timerManager())
+    {
+        m_eventThread.setProcessingBudget(budgetUs);
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::SlowEvent>(event)) {
+                k_busy_wait(std::get<MyEvents::SlowEvent>(event).busyTimeUs);
+                atomic_inc(&m_eventCount);
+            } else if (std::holds_alternative<MyEvents::StartTimerEvent>(event)) {
+                m_timer.start(std::get<MyEvents::StartTimerEvent>(event).durationMs, -1);
+            } else if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+        m_eventThread.start();
+    }
+
+    ~BudgetTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_timer;
+    atomic_t m_timerCount = ATOMIC_INIT(0);
+    atomic_t m_eventCount = ATOMIC_INIT(0);
+    /** The number of slow events handled when the timer last fired. */
+    atomic_t m_eventCountAtTimer = ATOMIC_INIT(0);
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(EventThreadBudgetTests, testOverrunIsCounted)
+{
+    BudgetTestClass testObj(1000);
+
+    // First handler fits inside the budget, the second one does not
+    testObj.m_eventThread.sendEvent(MyEvents::SlowEvent{ .busyTimeUs = 100 });
+    testObj.m_eventThread.sendEvent(MyEvents::SlowEvent{ .busyTimeUs = 5000 });
+    k_sleep(K_MSEC(50));
+
+    zassert_equal(atomic_get(&testObj.m_eventCount), 2, "Both events should have been handled.");
+    zassert_equal(testObj.m_eventThread.getNumBudgetOverruns(), 1, "Expected exactly one budget overrun. Got %u.",
+        testObj.m_eventThread.getNumBudgetOverruns());
+}
+
+ZTEST(EventThreadBudgetTests, testNoOverrunsWithoutBudget)
+{
+    BudgetTestClass testObj(0);
+
+    testObj.m_eventThread.sendEvent(MyEvents::SlowEvent{ .busyTimeUs = 5000 });
+    k_sleep(K_MSEC(50));
+
+    zassert_equal(atomic_get(&testObj.m_eventCount), 1, "Event should have been handled.");
+    zassert_equal(testObj.m_eventThread.getNumBudgetOverruns(), 0, "No budget set, so there should be no overruns.");
+}
+
+ZTEST(EventThreadBudgetTests, testTimerStartedMidDrainEndsDrain)
+{
+    BudgetTestClass testObj(20000);
+
+    // The first handler starts a timer which is due part way through draining the slow events queued behind it.
+    // No timer is running when the drain starts, so its limit is the whole 20ms budget. The timer only fires on time
+    // if the loop shortens the limit once the handler starts the timer.
+    testObj.m_eventThread.sendEvent(MyEvents::StartTimerEvent{ .durationMs = 2 });
+    for (int i = 0; i < 5; i++) {
+        testObj.m_eventThread.sendEvent(MyEvents::SlowEvent{ .busyTimeUs = 3000 });
+    }
+    k_sleep(K_MSEC(50));
+
+    zassert_equal(atomic_get(&testObj.m_eventCount), 5, "All events should have been handled.");
+    zassert_equal(atomic_get(&testObj.m_timerCount), 1, "Timer should have fired once.");
+    zassert_true(atomic_get(&testObj.m_eventCountAtTimer) <= 2,
+        "Timer should have fired after the event it became due in, not after the whole drain. Fired after %ld events.",
+        atomic_get(&testObj.m_eventCountAtTimer));
+}
+
+} // namespace
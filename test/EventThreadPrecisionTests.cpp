@@ -0,0 +1,136 @@
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <variant>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/counter.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/PrecisionAlarm.hpp"
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(EventThreadPrecisionTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(EventThreadPrecisionTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    using Generic = std::variant<ExitEvent>;
+} // namespace MyEvents
+
+class PrecisionTestClass {
+public:
+    PrecisionTestClass() :
+        m_eventThread(
+            "PrecisionTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_timer("PrecisionTimer", [this]() {
+            m_expiryHandled_ns = static_cast<int64_t>(k_cyc_to_ns_floor64(k_cycle_get_64()));
+        }, m_eventThread.timerManager())
+    {
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+    }
+
+    ~PrecisionTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_timer;
+    int64_t m_expiryHandled_ns = 0;
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(EventThreadPrecisionTests, testTimerExpiresBetweenTicks)
+{
+    const struct device* counter = DEVICE_DT_GET(DT_NODELABEL(counter0));
+    if (counter_get_frequency(counter) <= CONFIG_SYS_CLOCK_TICKS_PER_SEC) {
+        // The counter can't do any better than the system tick. On native_sim, boards/native_sim.conf speeds it up
+        ztest_test_skip();
+    }
+
+    PrecisionTestClass testObj;
+    zassert_ok(testObj.m_eventThread.setPrecisionCounter(counter));
+    // Pick a start duration which does not land on a tick
+    testObj.m_timer.start(std::chrono::microseconds(5050), std::chrono::microseconds(-1));
+    int64_t expiry_ns = testObj.m_timer.getNextExpiryTimeNs();
+    testObj.m_eventThread.start();
+    k_sleep(K_MSEC(20));
+
+    zassert_not_equal(testObj.m_expiryHandled_ns, 0, "Timer did not expire.");
+    int64_t lateness_ns = testObj.m_expiryHandled_ns - expiry_ns;
+    // Without the counter, the timer would not be handled until the next tick
+    int64_t tick_ns = static_cast<int64_t>(k_ticks_to_ns_floor64(1));
+    zassert_true(lateness_ns >= 0 && lateness_ns < tick_ns / 2, "Timer was handled %lld ns late.", lateness_ns);
+}
+
+ZTEST(EventThreadPrecisionTests, testDestroyedAlarmDoesNotFire)
+{
+    const struct device* counter = DEVICE_DT_GET(DT_NODELABEL(counter0));
+    static volatile uint32_t numAlarms;
+    numAlarms = 0;
+    {
+        zct::PrecisionAlarm alarm;
+        zassert_ok(alarm.configure(counter, 0, []() { numAlarms = numAlarms + 1; }));
+        zassert_ok(alarm.arm(2000000));
+    }
+    k_sleep(K_MSEC(5));
+    zassert_equal(numAlarms, 0, "Alarm fired after the PrecisionAlarm was destroyed.");
+}
+
+ZTEST(EventThreadPrecisionTests, testVeryLongDelayIsOutOfRange)
+{
+    const struct device* counter = DEVICE_DT_GET(DT_NODELABEL(counter0));
+    static volatile uint32_t numAlarms;
+    numAlarms = 0;
+    zct::PrecisionAlarm alarm;
+    zassert_ok(alarm.configure(counter, 0, []() { numAlarms = numAlarms + 1; }));
+
+    // The shortest delay for which delay_ns * frequency overflows 64 bits (about 5 hours at 1 MHz). Converting it
+    // to ticks naively wraps round to a delay of 1 tick.
+    uint64_t delay_ns = UINT64_MAX / counter_get_frequency(counter) + 1;
+    zassert_equal(alarm.arm(delay_ns), -ERANGE, "A delay of %llu ns should be too long for the counter.", delay_ns);
+    k_sleep(K_MSEC(5));
+    zassert_equal(numAlarms, 0, "Alarm fired early.");
+}
+
+ZTEST(EventThreadPrecisionTests, testDestroyWithRunningPeriodicTimer)
+{
+    const struct device* counter = DEVICE_DT_GET(DT_NODELABEL(counter0));
+
+    // Construct in static storage so the memory can be overwritten once the object is destroyed. A precision alarm
+    // left armed would then wake up garbage instead of silently working on freed memory which still looks valid.
+    alignas(PrecisionTestClass) static uint8_t storage[sizeof(PrecisionTestClass)];
+    PrecisionTestClass* testObj = new (storage) PrecisionTestClass();
+    zassert_ok(testObj->m_eventThread.setPrecisionCounter(counter));
+    testObj->m_timer.start(std::chrono::microseconds(1050), std::chrono::microseconds(1050));
+    testObj->m_eventThread.start();
+    k_sleep(K_MSEC(5));
+    zassert_not_equal(testObj->m_expiryHandled_ns, 0, "Timer did not expire.");
+
+    // The timer is still running when the event thread exits
+    testObj->~PrecisionTestClass();
+    memset(storage, 0xA5, sizeof(storage));
+
+    // Give an armed alarm plenty of time to fire
+    k_sleep(K_MSEC(10));
+}
+
+} // namespace
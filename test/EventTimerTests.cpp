@@ -0,0 +1,78 @@
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/EventTimer.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(EventTimerTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(EventTimerTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    struct TimerExpired {
+        uint32_t value;
+    };
+    using Generic = std::variant<ExitEvent, TimerExpired>;
+} // namespace MyEvents
+
+class EventTimerTestClass {
+public:
+    EventTimerTestClass() :
+        m_eventThread(
+            "EventTimerTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_timer("EventTimer", m_eventThread, MyEvents::TimerExpired{ .value = 1 })
+    {
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::TimerExpired>(event)) {
+                atomic_add(&m_valueSum, std::get<MyEvents::TimerExpired>(event).value);
+            } else if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+        m_eventThread.start();
+    }
+
+    ~EventTimerTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::EventTimer<MyEvents::Generic> m_timer;
+    atomic_t m_valueSum = ATOMIC_INIT(0);
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(EventTimerTests, testEventIsDeliveredOnExpiry)
+{
+    EventTimerTestClass testObj;
+    testObj.m_eventThread.runInLoop([&testObj]() {
+        testObj.m_timer.start(10, 10);
+    });
+    // Expiries at 10, 20 and 30ms
+    k_sleep(K_MSEC(35));
+    zassert_equal(atomic_get(&testObj.m_valueSum), 3, "Expected 3 expiries. Got %ld.", atomic_get(&testObj.m_valueSum));
+
+    // Changing the event changes what is delivered on the next expiry
+    testObj.m_eventThread.runInLoop([&testObj]() {
+        testObj.m_timer.setEvent(MyEvents::TimerExpired{ .value = 100 });
+        testObj.m_timer.start(10, -1);
+    });
+    k_sleep(K_MSEC(20));
+    zassert_equal(atomic_get(&testObj.m_valueSum), 103, "Expected the new event to be delivered. Got %ld.", atomic_get(&testObj.m_valueSum));
+}
+
+} // namespace
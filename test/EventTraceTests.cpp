@@ -0,0 +1,152 @@
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/Util.hpp"
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/EventTraceRecorder.hpp"
+#include "ZephyrCppToolkit/Events/EventTraceReplayer.hpp"
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(EventTraceTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(EventTraceTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    struct StartTimerEvent {
+        uint32_t durationMs;
+    };
+    using Generic = std::variant<ExitEvent, StartTimerEvent>;
+} // namespace MyEvents
+
+using zct::EventTraceRecorder;
+
+class TraceTestClass {
+public:
+    TraceTestClass(EventTraceRecorder& recorder) :
+        m_eventThread(
+            "TraceTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_timer("TraceTimer", []() {}, m_eventThread.timerManager())
+    {
+        m_eventThread.setTraceRecorder(&recorder);
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::StartTimerEvent>(event)) {
+                m_timer.start(std::get<MyEvents::StartTimerEvent>(event).durationMs, -1);
+            } else if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+        m_eventThread.start();
+    }
+
+    ~TraceTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_timer;
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(EventTraceTests, testDispatchesAreRecorded)
+{
+    EventTraceRecorder recorder(10, sizeof(MyEvents::Generic));
+    {
+        TraceTestClass testObj(recorder);
+        int64_t startTimeMs = k_uptime_get();
+        testObj.m_eventThread.sendEvent(MyEvents::StartTimerEvent{ .durationMs = 20 });
+        zct::Util::sleepUntilSystemTime(startTimeMs + 50);
+        recorder.setEnabled(false);
+    }
+
+    zassert_equal(recorder.getNumRecords(), 2, "Expected 2 records. Got %zu.", recorder.getNumRecords());
+
+    EventTraceRecorder::RecordHeader header;
+    MyEvents::Generic event;
+    zassert_true(recorder.getRecord(0, header, reinterpret_cast<uint8_t*>(&event), sizeof(event)));
+    zassert_equal(header.sourceType, EventTraceRecorder::SourceType::Event);
+    zassert_equal(header.sourceId, 1, "Source ID should be the variant index of StartTimerEvent.");
+    zassert_equal(header.payloadSize, sizeof(MyEvents::Generic));
+    zassert_equal(std::get<MyEvents::StartTimerEvent>(event).durationMs, 20);
+
+    int64_t eventTimestamp_ticks = header.timestamp_ticks;
+    zassert_true(recorder.getRecord(1, header, nullptr, 0));
+    zassert_equal(header.sourceType, EventTraceRecorder::SourceType::Timer);
+    zassert_true(header.timestamp_ticks - eventTimestamp_ticks >= (int64_t)k_ms_to_ticks_ceil64(20), "Timer should have expired 20ms after the event.");
+}
+
+ZTEST(EventTraceTests, testRingBufferOverwritesOldest)
+{
+    EventTraceRecorder recorder(2, 0);
+    recorder.record(EventTraceRecorder::SourceType::Function, 1, nullptr, 0);
+    recorder.record(EventTraceRecorder::SourceType::Function, 2, nullptr, 0);
+    recorder.record(EventTraceRecorder::SourceType::Function, 3, nullptr, 0);
+
+    EventTraceRecorder::RecordHeader header;
+    zassert_equal(recorder.getNumRecords(), 2);
+    zassert_equal(recorder.getNumOverwrittenRecords(), 1);
+    zassert_true(recorder.getRecord(0, header, nullptr, 0));
+    zassert_equal(header.sourceId, 2, "Oldest record should be the second one recorded.");
+    zassert_true(recorder.getRecord(1, header, nullptr, 0));
+    zassert_equal(header.sourceId, 3);
+    zassert_false(recorder.getRecord(2, header, nullptr, 0));
+}
+
+ZTEST(EventTraceTests, testReplayReproducesSequence)
+{
+    // Capture a trace
+    EventTraceRecorder captured(10, sizeof(MyEvents::Generic));
+    {
+        TraceTestClass testObj(captured);
+        int64_t startTimeMs = k_uptime_get();
+        testObj.m_eventThread.sendEvent(MyEvents::StartTimerEvent{ .durationMs = 30 });
+        zct::Util::sleepUntilSystemTime(startTimeMs + 10);
+        testObj.m_eventThread.sendEvent(MyEvents::StartTimerEvent{ .durationMs = 5 });
+        zct::Util::sleepUntilSystemTime(startTimeMs + 50);
+        captured.setEnabled(false);
+    }
+
+    // Replay it into a fresh event thread, recording what happens
+    EventTraceRecorder replayed(10, sizeof(MyEvents::Generic));
+    {
+        TraceTestClass testObj(replayed);
+        zct::EventTraceReplayer<MyEvents::Generic> replayer(captured, testObj.m_eventThread);
+        zassert_equal(replayer.replay(), 2, "Both events should have been replayed.");
+        k_sleep(K_MSEC(50));
+        replayed.setEnabled(false);
+    }
+
+    // Second event restarted the timer, so it should only have expired once
+    zassert_equal(captured.getNumRecords(), 3);
+    zassert_equal(replayed.getNumRecords(), captured.getNumRecords());
+    EventTraceRecorder::RecordHeader capturedHeader;
+    EventTraceRecorder::RecordHeader replayedHeader;
+    int64_t capturedStart_ticks = 0;
+    int64_t replayedStart_ticks = 0;
+    for (size_t i = 0; i < captured.getNumRecords(); i++) {
+        captured.getRecord(i, capturedHeader, nullptr, 0);
+        replayed.getRecord(i, replayedHeader, nullptr, 0);
+        if (i == 0) {
+            capturedStart_ticks = capturedHeader.timestamp_ticks;
+            replayedStart_ticks = replayedHeader.timestamp_ticks;
+        }
+        zassert_equal(replayedHeader.sourceType, capturedHeader.sourceType, "Record %zu has a different source.", i);
+        zassert_equal(replayedHeader.timestamp_ticks - replayedStart_ticks, capturedHeader.timestamp_ticks - capturedStart_ticks,
+            "Record %zu occurred at a different time.", i);
+    }
+}
+
+} // namespace
@@ -0,0 +1,59 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/FlatMap.hpp"
+
+ZTEST_SUITE(FlatMapTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(FlatMapTests, testInsertFindErase)
+{
+    zct::FlatMap<int, const char*, 4> map;
+    zassert_true(map.empty());
+
+    zassert_true(map.insert(3, "three"));
+    zassert_true(map.insert(1, "one"));
+    zassert_true(map.insert(2, "two"));
+    zassert_equal(map.size(), 3);
+
+    zassert_not_null(map.find(2));
+    zassert_str_equal(*map.find(2), "two");
+    zassert_is_null(map.find(4));
+    zassert_true(map.contains(1));
+    zassert_false(map.contains(0));
+
+    zassert_true(map.erase(1));
+    zassert_false(map.erase(1), "Erasing a missing key should fail.");
+    zassert_false(map.contains(1));
+    zassert_equal(map.size(), 2);
+}
+
+ZTEST(FlatMapTests, testInsertReplacesExistingValue)
+{
+    zct::FlatMap<int, int, 2> map;
+    zassert_true(map.insert(1, 10));
+    zassert_true(map.insert(2, 20));
+    zassert_true(map.full());
+
+    // Replacing doesn't need a free slot
+    zassert_true(map.insert(1, 11));
+    zassert_equal(*map.find(1), 11);
+    zassert_equal(map.size(), 2);
+
+    zassert_false(map.insert(3, 30), "Inserting a new key should fail when full.");
+    zassert_false(map.contains(3));
+}
+
+ZTEST(FlatMapTests, testIteratesInKeyOrder)
+{
+    zct::FlatMap<int, int, 8> map;
+    const int keys[] = { 5, 2, 7, 1, 6, 3 };
+    for (int key : keys) {
+        map.insert(key, key * 10);
+    }
+
+    int lastKey = 0;
+    for (const auto& entry : map) {
+        zassert_true(entry.first > lastKey, "Entries should be sorted by key.");
+        zassert_equal(entry.second, entry.first * 10);
+        lastKey = entry.first;
+    }
+}
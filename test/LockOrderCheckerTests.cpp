@@ -0,0 +1,111 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/LockOrderChecker.hpp"
+#include "ZephyrCppToolkit/Core/Mutex.hpp"
+
+ZTEST_SUITE(LockOrderCheckerTests, NULL, NULL, NULL, NULL, NULL);
+
+#if defined(ZCT_LOCK_ORDER_CHECKING) && ZCT_LOCK_ORDER_CHECKING
+
+static int numViolations = 0;
+static const zct::Mutex* violationHeld = nullptr;
+static const zct::Mutex* violationAcquiring = nullptr;
+
+static void recordViolation(const zct::Mutex& held, const zct::Mutex& acquiring)
+{
+    numViolations++;
+    violationHeld = &held;
+    violationAcquiring = &acquiring;
+}
+
+static void resetChecker()
+{
+    zct::LockOrderChecker::reset();
+    zct::LockOrderChecker::setViolationHandler(recordViolation);
+    numViolations = 0;
+    violationHeld = nullptr;
+    violationAcquiring = nullptr;
+}
+
+ZTEST(LockOrderCheckerTests, testConsistentOrderIsOk)
+{
+    resetChecker();
+    zct::Mutex mutexA("a");
+    zct::Mutex mutexB("b");
+
+    for (int i = 0; i < 3; i++) {
+        auto lockGuardA = mutexA.lockGuard(K_FOREVER);
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+    }
+    zassert_equal(numViolations, 0);
+
+    zct::LockOrderChecker::setViolationHandler(nullptr);
+}
+
+ZTEST(LockOrderCheckerTests, testInversionIsReported)
+{
+    resetChecker();
+    zct::Mutex mutexA("a");
+    zct::Mutex mutexB("b");
+    zct::Mutex mutexC("c");
+
+    // Record a -> b and b -> c
+    {
+        auto lockGuardA = mutexA.lockGuard(K_FOREVER);
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+    }
+    {
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+        auto lockGuardC = mutexC.lockGuard(K_FOREVER);
+    }
+    zassert_equal(numViolations, 0);
+
+    // c -> a closes the cycle, even though no deadlock happened this time
+    {
+        auto lockGuardC = mutexC.lockGuard(K_FOREVER);
+        auto lockGuardA = mutexA.lockGuard(K_FOREVER);
+    }
+    zassert_equal(numViolations, 1);
+    zassert_equal(violationHeld, &mutexC);
+    zassert_equal(violationAcquiring, &mutexA);
+
+    zct::LockOrderChecker::setViolationHandler(nullptr);
+}
+
+ZTEST(LockOrderCheckerTests, testTryLockAndRecursiveLockAreOk)
+{
+    resetChecker();
+    zct::Mutex mutexA("a");
+    zct::Mutex mutexB("b");
+
+    {
+        auto lockGuardA = mutexA.lockGuard(K_FOREVER);
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+    }
+
+    // A lock which doesn't wait can't deadlock
+    {
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+        auto lockGuardA = mutexA.lockGuard(K_NO_WAIT);
+        zassert_true(lockGuardA.didGetLock());
+    }
+
+    // Relocking a held mutex can't deadlock either
+    {
+        auto lockGuardA1 = mutexA.lockGuard(K_FOREVER);
+        auto lockGuardB = mutexB.lockGuard(K_FOREVER);
+        auto lockGuardA2 = mutexA.lockGuard(K_FOREVER);
+    }
+    zassert_equal(numViolations, 0);
+
+    zct::LockOrderChecker::setViolationHandler(nullptr);
+}
+
+#else
+
+ZTEST(LockOrderCheckerTests, testSkipped)
+{
+    ztest_test_skip();
+}
+
+#endif
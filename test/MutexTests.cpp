@@ -1,3 +1,4 @@
+#include <cstring>
 #include <type_traits>
 
 #include <zephyr/ztest.h>
@@ -63,5 +64,121 @@ ZTEST(MutexTests, testMutexLockGuard)
     zassert_false(tryLockInAnotherThread(mutex), "Mutex should be unlocked after lockGuard goes out of scope.");
 }
 
-// Make sure we can't copy or move the lock guard.
+K_THREAD_STACK_DEFINE(holderThreadStack, 1024);
+
+static void holdMutexThreadMain(void* arg1, void* arg2, void* arg3)
+{
+    zct::Mutex* mutex = static_cast<zct::Mutex*>(arg1);
+    struct k_sem* lockedSem = static_cast<struct k_sem*>(arg2);
+
+    auto lockGuard = mutex->lockGuard(K_FOREVER);
+    k_sem_give(lockedSem);
+    k_sleep(K_MSEC(20));
+}
+
+ZTEST(MutexTests, testStats)
+{
+    zct::Mutex mutex("test");
+    mutex.setStatsEnabled(true);
+
+    // Uncontended locks, including a recursive one which should not count
+    {
+        auto lockGuard1 = mutex.lockGuard(K_NO_WAIT);
+        auto lockGuard2 = mutex.lockGuard(K_NO_WAIT);
+    }
+    {
+        auto lockGuard = mutex.lockGuard(K_NO_WAIT);
+    }
+    zct::Mutex::Stats stats = mutex.getStats();
+    zassert_equal(stats.numAcquisitions, 2);
+    zassert_equal(stats.numContended, 0);
+
+    // Have another thread hold the mutex for 20ms while we wait for it
+    struct k_thread thread;
+    struct k_sem lockedSem;
+    k_sem_init(&lockedSem, 0, 1);
+    k_thread_create(&thread, holderThreadStack, K_THREAD_STACK_SIZEOF(holderThreadStack),
+                    holdMutexThreadMain, &mutex, &lockedSem, NULL,
+                    0, /* priority */
+                    0, /* options */
+                    K_NO_WAIT);
+    k_sem_take(&lockedSem, K_FOREVER);
+    {
+        auto lockGuard = mutex.lockGuard(K_FOREVER);
+        zassert_true(lockGuard.didGetLock());
+    }
+    k_thread_join(&thread, K_FOREVER);
+
+    stats = mutex.getStats();
+    zassert_equal(stats.numAcquisitions, 4);
+    zassert_equal(stats.numContended, 1);
+    zassert_true(stats.maxWaitTime_us >= 10000, "Wait time was %u us.", stats.maxWaitTime_us);
+    zassert_true(stats.maxHoldTime_us >= 10000, "Hold time was %u us.", stats.maxHoldTime_us);
+    zassert_true(stats.totalWaitTime_us >= stats.maxWaitTime_us);
+
+    mutex.resetStats();
+    stats = mutex.getStats();
+    zassert_equal(stats.numAcquisitions, 0);
+    zassert_equal(stats.maxHoldTime_us, 0);
+}
+
+ZTEST(MutexTests, testRegistry)
+{
+    auto countNamed = [](const char* name) {
+        int count = 0;
+        zct::Mutex::forEach([&](zct::Mutex& mutex) {
+            if (mutex.getName() != nullptr && strcmp(mutex.getName(), name) == 0) {
+                count++;
+            }
+        });
+        return count;
+    };
+
+    {
+        zct::Mutex mutex("registryTest");
+        zassert_equal(countNamed("registryTest"), 1);
+        mutex.setStatsEnabled(true);
+        zct::Mutex::logAll();
+    }
+    zassert_equal(countNamed("registryTest"), 0, "Mutex should be removed from the registry when destroyed.");
+}
+
+ZTEST(MutexTests, testLockAll)
+{
+    zct::Mutex mutexA;
+    zct::Mutex mutexB;
+
+    {
+        auto lockGuard = zct::lockAll(K_MSEC(100), mutexA, mutexB);
+        zassert_true(lockGuard.has_value());
+        zassert_true(tryLockInAnotherThread(mutexA));
+        zassert_true(tryLockInAnotherThread(mutexB));
+    }
+    zassert_false(tryLockInAnotherThread(mutexA));
+    zassert_false(tryLockInAnotherThread(mutexB));
+
+    // With one mutex held by another thread, lockAll() must fail and leave the other one unlocked
+    struct k_thread thread;
+    struct k_sem lockedSem;
+    k_sem_init(&lockedSem, 0, 1);
+    k_thread_create(&thread, holderThreadStack, K_THREAD_STACK_SIZEOF(holderThreadStack),
+                    holdMutexThreadMain, &mutexB, &lockedSem, NULL,
+                    0, /* priority */
+                    0, /* options */
+                    K_NO_WAIT);
+    k_sem_take(&lockedSem, K_FOREVER);
+
+    auto failedLockGuard = zct::lockAll(K_NO_WAIT, mutexA, mutexB);
+    zassert_false(failedLockGuard.has_value());
+    zassert_equal(failedLockGuard.error(), -EBUSY);
+    zassert_false(tryLockInAnotherThread(mutexA), "Mutex A should have been released on failure.");
+
+    // Once the holder finishes (after 20ms), both can be locked
+    auto lockGuard = zct::lockAll(K_MSEC(500), mutexB, mutexA);
+    zassert_true(lockGuard.has_value());
+    k_thread_join(&thread, K_FOREVER);
+}
+
+// Make sure we can't copy the lock guard.
 static_assert(!std::is_copy_constructible_v<zct::MutexLockGuard>);
+static_assert(!std::is_copy_constructible_v<zct::Mutex>);
@@ -0,0 +1,71 @@
+#include <utility>
+
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/Pool.hpp"
+
+ZTEST_SUITE(PoolTests, NULL, NULL, NULL, NULL, NULL);
+
+static int numLiveObjects = 0;
+
+struct Packet {
+    Packet(uint32_t id) :
+        id(id)
+    {
+        numLiveObjects++;
+    }
+
+    ~Packet()
+    {
+        numLiveObjects--;
+    }
+
+    uint32_t id;
+    uint8_t payload[20];
+};
+
+ZTEST(PoolTests, testAllocateAndFree)
+{
+    static zct::Pool<Packet, 3> pool;
+    numLiveObjects = 0;
+
+    {
+        auto packet = pool.allocate(K_NO_WAIT, 42u);
+        zassert_true(packet.has_value());
+        zassert_equal((*packet)->id, 42);
+        zassert_equal(numLiveObjects, 1);
+        zassert_equal(pool.getNumUsed(), 1);
+        zassert_equal(pool.getNumFree(), 2);
+        zassert_equal(reinterpret_cast<uintptr_t>(packet->get()) % alignof(Packet), 0);
+    }
+
+    // The handle went out of scope, so the object is destroyed and the block is free again
+    zassert_equal(numLiveObjects, 0);
+    zassert_equal(pool.getNumUsed(), 0);
+    zassert_equal(pool.getMaxUsed(), 1);
+}
+
+ZTEST(PoolTests, testExhaustion)
+{
+    static zct::Pool<Packet, 2> pool;
+
+    auto packet1 = pool.allocate(K_NO_WAIT, 1u);
+    auto packet2 = pool.allocate(K_NO_WAIT, 2u);
+    zassert_true(packet1.has_value());
+    zassert_true(packet2.has_value());
+
+    auto packet3 = pool.allocate(K_NO_WAIT, 3u);
+    zassert_false(packet3.has_value());
+    zassert_equal(packet3.error(), -ENOMEM);
+
+    auto packet4 = pool.allocate(K_MSEC(5), 4u);
+    zassert_false(packet4.has_value());
+    zassert_equal(packet4.error(), -EAGAIN);
+
+    // Handing ownership on and then releasing it frees the block
+    zct::Pool<Packet, 2>::Ptr owner = std::move(*packet1);
+    owner.reset();
+    auto packet5 = pool.allocate(K_NO_WAIT, 5u);
+    zassert_true(packet5.has_value());
+    zassert_equal(pool.getMaxUsed(), 2);
+}
@@ -0,0 +1,152 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/RingBuffer.hpp"
+
+ZTEST_SUITE(RingBufferTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(RingBufferTests, testPushPopInOrder)
+{
+    zct::RingBuffer<int, 4> ringBuffer;
+    zassert_true(ringBuffer.empty());
+
+    for (int i = 0; i < 4; i++) {
+        zassert_true(ringBuffer.push(i));
+    }
+    zassert_true(ringBuffer.full());
+    zassert_false(ringBuffer.push(4), "Push should fail when full.");
+
+    int item = -1;
+    for (int i = 0; i < 4; i++) {
+        zassert_true(ringBuffer.pop(item));
+        zassert_equal(item, i);
+    }
+    zassert_false(ringBuffer.pop(item), "Pop should fail when empty.");
+}
+
+ZTEST(RingBufferTests, testWrapsAround)
+{
+    zct::RingBuffer<int, 4> ringBuffer;
+    int item = -1;
+    for (int i = 0; i < 10; i++) {
+        zassert_true(ringBuffer.push(i));
+        zassert_true(ringBuffer.push(i + 100));
+        zassert_true(ringBuffer.pop(item));
+        zassert_equal(item, i);
+        zassert_true(ringBuffer.pop(item));
+        zassert_equal(item, i + 100);
+    }
+    zassert_equal(ringBuffer.size(), 0);
+}
+
+/** Allows the free-running counters to be started just below where they wrap. */
+class TestRingBuffer : public zct::RingBuffer<int, 4> {
+public:
+    void setCounts(uint32_t count)
+    {
+        setCount(m_head, count);
+        setCount(m_tail, count);
+    }
+};
+
+ZTEST(RingBufferTests, testCountersWrapAround)
+{
+    TestRingBuffer ringBuffer;
+    ringBuffer.setCounts(UINT32_MAX - 1);
+    int item = -1;
+    for (int i = 0; i < 10; i++) {
+        zassert_true(ringBuffer.push(i));
+        zassert_true(ringBuffer.push(i + 100));
+        zassert_equal(ringBuffer.size(), 2);
+        zassert_true(ringBuffer.pop(item));
+        zassert_equal(item, i);
+        zassert_true(ringBuffer.pop(item));
+        zassert_equal(item, i + 100);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        zassert_true(ringBuffer.push(i));
+    }
+    zassert_false(ringBuffer.push(4), "Push should fail when full, even after the counters wrap.");
+}
+
+static constinit zct::RingBuffer<uint32_t, 64> isrRingBuffer;
+static uint32_t isrNextValue = 0;
+static uint32_t isrNumDropped = 0;
+
+static void producerTimerExpiry(struct k_timer* timer)
+{
+    // Runs in interrupt context
+    if (isrRingBuffer.push(isrNextValue)) {
+        isrNextValue++;
+    } else {
+        isrNumDropped++;
+    }
+}
+
+K_TIMER_DEFINE(producerTimer, producerTimerExpiry, NULL);
+
+ZTEST(RingBufferTests, testIsrProducer)
+{
+    k_timer_start(&producerTimer, K_USEC(100), K_USEC(100));
+
+    uint32_t expectedValue = 0;
+    int64_t endTime_ms = k_uptime_get() + 50;
+    while (k_uptime_get() < endTime_ms) {
+        uint32_t value;
+        while (isrRingBuffer.pop(value)) {
+            zassert_equal(value, expectedValue, "Items should arrive in order, none lost or repeated.");
+            expectedValue++;
+        }
+        k_busy_wait(7);
+    }
+
+    k_timer_stop(&producerTimer);
+    zassert_true(expectedValue > 0, "Timer ISR should have produced items.");
+}
+
+static constinit zct::RingBuffer<uint32_t, 16, true> multiRingBuffer;
+static constexpr uint32_t NUM_PER_PRODUCER = 1000;
+
+static void producerThreadEntry(void* p1, void*, void*)
+{
+    uint32_t base = reinterpret_cast<uintptr_t>(p1);
+    for (uint32_t i = 0; i < NUM_PER_PRODUCER; i++) {
+        while (!multiRingBuffer.push(base + i)) {
+            k_yield();
+        }
+    }
+}
+
+K_THREAD_STACK_DEFINE(producerStack1, 1024);
+K_THREAD_STACK_DEFINE(producerStack2, 1024);
+
+ZTEST(RingBufferTests, testMultipleProducers)
+{
+    struct k_thread thread1;
+    struct k_thread thread2;
+    k_thread_create(&thread1, producerStack1, K_THREAD_STACK_SIZEOF(producerStack1), producerThreadEntry,
+                    reinterpret_cast<void*>(0), NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+    k_thread_create(&thread2, producerStack2, K_THREAD_STACK_SIZEOF(producerStack2), producerThreadEntry,
+                    reinterpret_cast<void*>(static_cast<uintptr_t>(NUM_PER_PRODUCER)), NULL, NULL, K_PRIO_PREEMPT(5),
+                    0, K_NO_WAIT);
+
+    // Each producer's items must arrive in the order it pushed them, interleaved with the other's
+    uint32_t nextFromProducer[2] = { 0, NUM_PER_PRODUCER };
+    uint32_t numReceived = 0;
+    while (numReceived < 2 * NUM_PER_PRODUCER) {
+        uint32_t value;
+        if (!multiRingBuffer.pop(value)) {
+            k_yield();
+            continue;
+        }
+        uint32_t producer = value / NUM_PER_PRODUCER;
+        zassert_true(producer < 2);
+        zassert_equal(value, nextFromProducer[producer]);
+        nextFromProducer[producer]++;
+        numReceived++;
+    }
+
+    k_thread_join(&thread1, K_FOREVER);
+    k_thread_join(&thread2, K_FOREVER);
+    zassert_true(multiRingBuffer.empty());
+}
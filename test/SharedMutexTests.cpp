@@ -0,0 +1,148 @@
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/SharedMutex.hpp"
+
+ZTEST_SUITE(SharedMutexTests, NULL, NULL, NULL, NULL, NULL);
+
+K_THREAD_STACK_DEFINE(sharedMutexThreadStack, 1024);
+
+struct LockAttempt {
+    zct::SharedMutex* sharedMutex;
+    bool isWrite;
+    k_timeout_t timeout;
+    bool didGetLock;
+};
+
+static void lockAttemptThreadMain(void* arg1, void* arg2, void* arg3)
+{
+    LockAttempt* attempt = static_cast<LockAttempt*>(arg1);
+    struct k_sem* completionSem = static_cast<struct k_sem*>(arg2);
+
+    if (attempt->isWrite) {
+        auto guard = attempt->sharedMutex->writeGuard(attempt->timeout);
+        attempt->didGetLock = guard.didGetLock();
+    } else {
+        auto guard = attempt->sharedMutex->readGuard(attempt->timeout);
+        attempt->didGetLock = guard.didGetLock();
+    }
+    k_sem_give(completionSem);
+}
+
+/**
+ * Try and lock the shared mutex from another thread, since the calling thread may already hold it.
+ */
+static bool tryLockInAnotherThread(zct::SharedMutex& sharedMutex, bool isWrite, k_timeout_t timeout = K_NO_WAIT)
+{
+    struct k_thread thread;
+    struct k_sem completionSem;
+    k_sem_init(&completionSem, 0, 1);
+    LockAttempt attempt = { &sharedMutex, isWrite, timeout, false };
+
+    k_thread_create(&thread, sharedMutexThreadStack, K_THREAD_STACK_SIZEOF(sharedMutexThreadStack),
+                    lockAttemptThreadMain, &attempt, &completionSem, NULL,
+                    0, /* priority */
+                    0, /* options */
+                    K_NO_WAIT);
+
+    k_sem_take(&completionSem, K_FOREVER);
+    k_thread_join(&thread, K_FOREVER);
+
+    return attempt.didGetLock;
+}
+
+ZTEST(SharedMutexTests, testReadersShareTheLock)
+{
+    zct::SharedMutex sharedMutex;
+
+    {
+        auto readGuard = sharedMutex.readGuard(K_NO_WAIT);
+        zassert_true(readGuard.didGetLock());
+        zassert_equal(sharedMutex.getNumReaders(), 1);
+
+        // Another reader gets in, a writer does not
+        zassert_true(tryLockInAnotherThread(sharedMutex, false));
+        zassert_false(tryLockInAnotherThread(sharedMutex, true));
+        zassert_false(tryLockInAnotherThread(sharedMutex, true, K_MSEC(10)));
+    }
+
+    zassert_equal(sharedMutex.getNumReaders(), 0);
+    zassert_true(tryLockInAnotherThread(sharedMutex, true));
+}
+
+ZTEST(SharedMutexTests, testWriterIsExclusive)
+{
+    zct::SharedMutex sharedMutex;
+
+    {
+        auto writeGuard = sharedMutex.writeGuard(K_NO_WAIT);
+        zassert_true(writeGuard.didGetLock());
+
+        zassert_false(tryLockInAnotherThread(sharedMutex, false));
+        zassert_false(tryLockInAnotherThread(sharedMutex, false, K_MSEC(10)));
+        zassert_false(tryLockInAnotherThread(sharedMutex, true));
+    }
+
+    zassert_true(tryLockInAnotherThread(sharedMutex, false));
+    zassert_true(tryLockInAnotherThread(sharedMutex, true));
+}
+
+ZTEST(SharedMutexTests, testGuardCanBeMoved)
+{
+    zct::SharedMutex sharedMutex;
+
+    {
+        auto readGuard = sharedMutex.readGuard(K_NO_WAIT);
+        zct::SharedMutexReadGuard movedGuard(std::move(readGuard));
+        zassert_false(readGuard.didGetLock());
+        zassert_true(movedGuard.didGetLock());
+        zassert_equal(sharedMutex.getNumReaders(), 1);
+    }
+
+    // Only the moved-to guard unlocked
+    zassert_equal(sharedMutex.getNumReaders(), 0);
+}
+
+K_THREAD_STACK_DEFINE(waitingWriterThreadStack, 1024);
+
+ZTEST(SharedMutexTests, testWaitingWriterBlocksNewReaders)
+{
+    for (auto preference : { zct::SharedMutex::Preference::Writer, zct::SharedMutex::Preference::Reader }) {
+        zct::SharedMutex sharedMutex(preference);
+        struct k_thread writerThread;
+        struct k_sem writerCompletionSem;
+        k_sem_init(&writerCompletionSem, 0, 1);
+        LockAttempt writerAttempt = { &sharedMutex, true, K_MSEC(500), false };
+
+        {
+            auto readGuard = sharedMutex.readGuard(K_NO_WAIT);
+            zassert_true(readGuard.didGetLock());
+
+            // Start a writer which waits for the reader to finish
+            k_thread_create(&writerThread, waitingWriterThreadStack, K_THREAD_STACK_SIZEOF(waitingWriterThreadStack),
+                            lockAttemptThreadMain, &writerAttempt, &writerCompletionSem, NULL,
+                            0, /* priority */
+                            0, /* options */
+                            K_NO_WAIT);
+            k_sleep(K_MSEC(10));
+
+            bool didNewReaderGetLock = tryLockInAnotherThread(sharedMutex, false);
+            if (preference == zct::SharedMutex::Preference::Writer) {
+                zassert_false(didNewReaderGetLock, "New reader should wait behind the waiting writer.");
+            } else {
+                zassert_true(didNewReaderGetLock, "New reader should get in while only readers hold the lock.");
+            }
+        } // readGuard goes out of scope, letting the writer in
+
+        k_sem_take(&writerCompletionSem, K_FOREVER);
+        k_thread_join(&writerThread, K_FOREVER);
+        zassert_true(writerAttempt.didGetLock);
+    }
+}
+
+// Make sure we can't copy the guards.
+static_assert(!std::is_copy_constructible_v<zct::SharedMutexReadGuard>);
+static_assert(!std::is_copy_constructible_v<zct::SharedMutexWriteGuard>);
@@ -0,0 +1,63 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/SlotAllocator.hpp"
+
+ZTEST_SUITE(SlotAllocatorTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(SlotAllocatorTests, testAllocateAndFree)
+{
+    // More slots than fit in one atomic_t, to cover the word boundary
+    zct::SlotAllocator<40> slots;
+    zassert_equal(slots.getNumAllocated(), 0);
+
+    for (int i = 0; i < 40; i++) {
+        zassert_equal(slots.allocate(), i, "The lowest free slot should be allocated.");
+    }
+    zassert_equal(slots.getNumAllocated(), 40);
+    zassert_equal(slots.allocate(), -ENOMEM, "Allocate should fail when every slot is used.");
+
+    slots.free(33);
+    zassert_false(slots.isAllocated(33));
+    zassert_equal(slots.getNumAllocated(), 39);
+    zassert_equal(slots.allocate(), 33, "A freed slot should be reused.");
+    zassert_true(slots.isAllocated(33));
+}
+
+static constinit zct::SlotAllocator<32> isrSlots;
+static volatile uint32_t isrNumAllocFailures = 0;
+
+static void allocatorTimerExpiry(struct k_timer* timer)
+{
+    // Runs in interrupt context, competing with the test thread for slots
+    int slot = isrSlots.allocate();
+    if (slot < 0) {
+        isrNumAllocFailures = isrNumAllocFailures + 1;
+        return;
+    }
+    isrSlots.free(slot);
+}
+
+K_TIMER_DEFINE(allocatorTimer, allocatorTimerExpiry, NULL);
+
+ZTEST(SlotAllocatorTests, testAllocateFromIsr)
+{
+    k_timer_start(&allocatorTimer, K_USEC(100), K_USEC(100));
+
+    int64_t endTime_ms = k_uptime_get() + 50;
+    while (k_uptime_get() < endTime_ms) {
+        int slots[8];
+        for (int& slot : slots) {
+            slot = isrSlots.allocate();
+            zassert_true(slot >= 0);
+        }
+        k_busy_wait(7);
+        for (int slot : slots) {
+            zassert_true(isrSlots.isAllocated(slot), "No one else should have freed our slot.");
+            isrSlots.free(slot);
+        }
+    }
+
+    k_timer_stop(&allocatorTimer);
+    zassert_equal(isrNumAllocFailures, 0);
+    zassert_equal(isrSlots.getNumAllocated(), 0);
+}
@@ -0,0 +1,83 @@
+#include <type_traits>
+#include <utility>
+
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/SpinLock.hpp"
+
+ZTEST_SUITE(SpinLockTests, NULL, NULL, NULL, NULL, NULL);
+
+struct SharedCounter {
+    zct::SpinLock spinLock;
+    uint32_t count = 0;
+};
+
+static SharedCounter sharedCounter;
+
+static void counterTimerExpiry(struct k_timer* timer)
+{
+    // Runs in interrupt context
+    auto guard = sharedCounter.spinLock.lockGuard();
+    sharedCounter.count++;
+}
+
+K_TIMER_DEFINE(counterTimer, counterTimerExpiry, NULL);
+
+ZTEST(SpinLockTests, testSharedWithIsr)
+{
+    sharedCounter.count = 0;
+    k_timer_start(&counterTimer, K_MSEC(1), K_MSEC(1));
+
+    uint32_t lastCount = 0;
+    for (int i = 0; i < 20; i++) {
+        {
+            auto guard = sharedCounter.spinLock.lockGuard();
+            // The ISR can't run while we hold the lock, so the count can't change under us
+            lastCount = sharedCounter.count;
+            k_busy_wait(100);
+            zassert_equal(sharedCounter.count, lastCount);
+        }
+        k_sleep(K_MSEC(1));
+    }
+
+    k_timer_stop(&counterTimer);
+    zassert_true(sharedCounter.count > 0, "Timer ISR should have run.");
+}
+
+ZTEST(SpinLockTests, testMaxHoldTime)
+{
+    zct::SpinLock spinLock;
+    zassert_equal(spinLock.getMaxHoldTime_cycles(), 0);
+
+    {
+        auto guard = spinLock.lockGuard();
+        k_busy_wait(1000);
+    }
+
+#if defined(CONFIG_ASSERT) && CONFIG_ASSERT
+    uint32_t expectedMin_cycles = static_cast<uint32_t>(k_us_to_cyc_floor64(500));
+    zassert_true(spinLock.getMaxHoldTime_cycles() >= expectedMin_cycles, "Hold time should have been measured.");
+#else
+    zassert_equal(spinLock.getMaxHoldTime_cycles(), 0);
+#endif
+
+    spinLock.resetMaxHoldTime();
+    zassert_equal(spinLock.getMaxHoldTime_cycles(), 0);
+}
+
+ZTEST(SpinLockTests, testMovedGuardUnlocksOnce)
+{
+    zct::SpinLock spinLock;
+    {
+        auto guard = spinLock.lockGuard();
+        zct::SpinLockGuard movedGuard(std::move(guard));
+    }
+
+    // If the lock had not been released (or had been released twice), this would assert or hang
+    {
+        auto guard = spinLock.lockGuard();
+    }
+}
+
+// Make sure we can't copy the lock guard.
+static_assert(!std::is_copy_constructible_v<zct::SpinLockGuard>);
@@ -0,0 +1,292 @@
+#include <cstring>
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/StateMachine.hpp"
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(StateMachineTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(StateMachineTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    struct TurnOnEvent {};
+    struct TurnOffEvent {};
+    struct BrightEvent {};
+    struct DimTimerExpiredEvent {};
+    using Generic = std::variant<ExitEvent, TurnOnEvent, TurnOffEvent, BrightEvent, DimTimerExpiredEvent>;
+} // namespace MyEvents
+
+enum class LightState : uint8_t {
+    Off,
+    On,
+    Dim,
+    Bright,
+};
+
+/**
+ * Records the entry/exit actions in the order they occurred. Lives outside the test class so it can be
+ * checked after the event thread has exited.
+ */
+class ActionLog {
+public:
+    void add(const char* action) {
+        __ASSERT_NO_MSG(m_numActions < MAX_NUM_ACTIONS);
+        m_actions[m_numActions++] = action;
+    }
+
+    bool equals(const char* const* expected, size_t numExpected) const {
+        if (numExpected != m_numActions) {
+            return false;
+        }
+        for (size_t i = 0; i < numExpected; i++) {
+            if (strcmp(expected[i], m_actions[i]) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_NUM_ACTIONS = 20;
+    const char* m_actions[MAX_NUM_ACTIONS];
+    size_t m_numActions = 0;
+};
+
+class Light : public zct::StateMachine<Light, MyEvents::Generic, LightState> {
+public:
+    Light(ActionLog& log) :
+        StateMachine(m_eventThread, 1),
+        m_log(log),
+        m_eventThread(
+            "Light",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_dimTimer("DimTimer", [this]() { dispatch(MyEvents::DimTimerExpiredEvent()); }, m_eventThread.timerManager())
+    {
+        scopeTimer(m_dimTimer, LightState::Bright);
+        start(LightState::Off);
+        m_eventThread.start();
+    }
+
+    ~Light() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    void send(const MyEvents::Generic& event) {
+        m_eventThread.sendEvent(event);
+    }
+
+    bool isDimTimerRunning() const {
+        return m_dimTimer.isRunning();
+    }
+
+    void onOffEntry() { m_log.add("Off entry"); }
+    void onOffExit() { m_log.add("Off exit"); }
+    bool onOffEvent(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::TurnOnEvent>(event)) {
+            transitionTo(LightState::On);
+            return true;
+        }
+        return false;
+    }
+
+    void onOnEntry() { m_log.add("On entry"); }
+    void onOnExit() { m_log.add("On exit"); }
+    bool onOnEvent(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::TurnOffEvent>(event)) {
+            transitionTo(LightState::Off);
+            return true;
+        }
+        return false;
+    }
+
+    void onDimEntry() { m_log.add("Dim entry"); }
+    void onDimExit() { m_log.add("Dim exit"); }
+    bool onDimEvent(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::BrightEvent>(event)) {
+            transitionTo(LightState::Bright);
+            return true;
+        }
+        return false;
+    }
+
+    void onBrightEntry() {
+        m_log.add("Bright entry");
+        m_dimTimer.start(50, -1);
+    }
+    void onBrightExit() { m_log.add("Bright exit"); }
+    bool onBrightEvent(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::DimTimerExpiredEvent>(event)) {
+            transitionTo(LightState::Dim);
+            return true;
+        }
+        return false;
+    }
+
+    /** Handled at the top level in every state, so it is not part of the state table. */
+    bool handleExit(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+            m_eventThread.exitEventLoop();
+            return true;
+        }
+        return false;
+    }
+
+
+private:
+    bool onOffEventOrExit(const MyEvents::Generic& event) { return handleExit(event) || onOffEvent(event); }
+    bool onOnEventOrExit(const MyEvents::Generic& event) { return handleExit(event) || onOnEvent(event); }
+
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+
+    ActionLog& m_log;
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_dimTimer;
+
+public:
+    // Defined after all the handlers so that they can be referenced
+    static constexpr State STATES[] = {
+        { .id = LightState::Off, .parent = std::nullopt, .initial = std::nullopt, .entry = &Light::onOffEntry, .exit = &Light::onOffExit, .handleEvent = &Light::onOffEventOrExit },
+        { .id = LightState::On, .parent = std::nullopt, .initial = LightState::Dim, .entry = &Light::onOnEntry, .exit = &Light::onOnExit, .handleEvent = &Light::onOnEventOrExit },
+        { .id = LightState::Dim, .parent = LightState::On, .initial = std::nullopt, .entry = &Light::onDimEntry, .exit = &Light::onDimExit, .handleEvent = &Light::onDimEvent },
+        { .id = LightState::Bright, .parent = LightState::On, .initial = std::nullopt, .entry = &Light::onBrightEntry, .exit = &Light::onBrightExit, .handleEvent = &Light::onBrightEvent },
+    };
+};
+
+ZTEST(StateMachineTests, testEntryAndExitOrder)
+{
+    ActionLog log;
+    {
+        Light light(log);
+        light.send(MyEvents::TurnOnEvent());
+        light.send(MyEvents::BrightEvent());
+        light.send(MyEvents::TurnOffEvent());
+        k_sleep(K_MSEC(10));
+        zassert_false(light.isDimTimerRunning(), "Dim timer should have been stopped when leaving the Bright state.");
+    }
+
+    // Entering On drills into its initial substate Dim, and turning off from Bright exits both Bright and On
+    const char* expected[] = {
+        "Off entry",
+        "Off exit", "On entry", "Dim entry",
+        "Dim exit", "Bright entry",
+        "Bright exit", "On exit", "Off entry",
+    };
+    zassert_true(log.equals(expected, ARRAY_SIZE(expected)), "Entry/exit actions did not occur in the expected order.");
+}
+
+ZTEST(StateMachineTests, testScopedTimerDrivesTransition)
+{
+    ActionLog log;
+    {
+        Light light(log);
+        light.send(MyEvents::TurnOnEvent());
+        light.send(MyEvents::BrightEvent());
+        k_sleep(K_MSEC(100));
+    }
+
+    // The dim timer expires while in Bright, which moves back to Dim without leaving On
+    const char* expected[] = {
+        "Off entry",
+        "Off exit", "On entry", "Dim entry",
+        "Dim exit", "Bright entry",
+        "Bright exit", "Dim entry",
+    };
+    zassert_true(log.equals(expected, ARRAY_SIZE(expected)), "Entry/exit actions did not occur in the expected order.");
+}
+
+enum class SwitchState : uint8_t {
+    Off,
+    On,
+};
+
+/** A minimal state machine with its scoped timer list reserved inside the object. */
+class Switch : public zct::StaticStateMachine<Switch, MyEvents::Generic, SwitchState, 2> {
+public:
+    Switch() :
+        StaticStateMachine(m_eventThread),
+        m_eventThread(
+            "Switch",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_timer1("Timer1", []() {}, m_eventThread.timerManager()),
+        m_timer2("Timer2", []() {}, m_eventThread.timerManager())
+    {
+        scopeTimer(m_timer1, SwitchState::On);
+        scopeTimer(m_timer2, SwitchState::On);
+        start(SwitchState::Off);
+        m_eventThread.start();
+    }
+
+    ~Switch() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    void send(const MyEvents::Generic& event) {
+        m_eventThread.sendEvent(event);
+    }
+
+    bool areTimersRunning() const {
+        return m_timer1.isRunning() || m_timer2.isRunning();
+    }
+
+private:
+    void onOnEntry() {
+        m_timer1.start(1000, -1);
+        m_timer2.start(1000, 1000);
+    }
+
+    bool onEvent(const MyEvents::Generic& event) {
+        if (std::holds_alternative<MyEvents::TurnOnEvent>(event)) {
+            transitionTo(SwitchState::On);
+        } else if (std::holds_alternative<MyEvents::TurnOffEvent>(event)) {
+            transitionTo(SwitchState::Off);
+        } else if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+            m_eventThread.exitEventLoop();
+        }
+        return true;
+    }
+
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_timer1;
+    zct::Timer m_timer2;
+
+public:
+    static constexpr State STATES[] = {
+        { .id = SwitchState::Off, .parent = std::nullopt, .initial = std::nullopt, .entry = nullptr, .exit = nullptr, .handleEvent = &Switch::onEvent },
+        { .id = SwitchState::On, .parent = std::nullopt, .initial = std::nullopt, .entry = &Switch::onOnEntry, .exit = nullptr, .handleEvent = &Switch::onEvent },
+    };
+};
+
+ZTEST(StateMachineTests, testStaticStateMachineScopedTimers)
+{
+    Switch lightSwitch;
+    lightSwitch.send(MyEvents::TurnOnEvent());
+    k_sleep(K_MSEC(10));
+    zassert_true(lightSwitch.areTimersRunning(), "Timers should have been started on entry to On.");
+
+    lightSwitch.send(MyEvents::TurnOffEvent());
+    k_sleep(K_MSEC(10));
+    zassert_false(lightSwitch.areTimersRunning(), "Both scoped timers should have been stopped when leaving On.");
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+#include <string>
+
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/StaticVector.hpp"
+
+ZTEST_SUITE(StaticVectorTests, NULL, NULL, NULL, NULL, NULL);
+
+/** Usable before main() runs, with no constructor code. */
+static constinit zct::StaticVector<int, 4> globalVector;
+
+static constexpr int sumOfPushed()
+{
+    zct::StaticVector<int, 4> vector;
+    vector.push_back(1);
+    vector.push_back(2);
+    vector.push_back(3);
+    int sum = 0;
+    for (int item : vector) {
+        sum += item;
+    }
+    return sum;
+}
+static_assert(sumOfPushed() == 6, "StaticVector should be usable in constant expressions.");
+
+ZTEST(StaticVectorTests, testPushPopAndCapacity)
+{
+    zassert_true(globalVector.empty());
+    zassert_equal(globalVector.capacity(), 4);
+
+    for (int i = 0; i < 4; i++) {
+        zassert_true(globalVector.push_back(i));
+    }
+    zassert_true(globalVector.full());
+    zassert_false(globalVector.push_back(4), "Push should fail when full.");
+    zassert_is_null(globalVector.emplace_back(4), "Emplace should fail when full.");
+    zassert_equal(globalVector.size(), 4);
+    zassert_equal(globalVector.front(), 0);
+    zassert_equal(globalVector.back(), 3);
+
+    globalVector.pop_back();
+    zassert_equal(globalVector.size(), 3);
+    zassert_equal(globalVector.back(), 2);
+
+    globalVector.clear();
+    zassert_true(globalVector.empty());
+}
+
+ZTEST(StaticVectorTests, testInsertAndErase)
+{
+    zct::StaticVector<int, 4> vector;
+    vector.push_back(1);
+    vector.push_back(3);
+
+    vector.insert(vector.begin() + 1, 2);
+    vector.insert(vector.begin(), 0);
+    zassert_equal(vector.size(), 4);
+    for (int i = 0; i < 4; i++) {
+        zassert_equal(vector[i], i);
+    }
+    zassert_equal(vector.insert(vector.begin(), 5), vector.end(), "Insert should fail when full.");
+
+    vector.erase(vector.begin() + 1);
+    zassert_equal(vector.size(), 3);
+    zassert_equal(vector[0], 0);
+    zassert_equal(vector[1], 2);
+    zassert_equal(vector[2], 3);
+}
+
+ZTEST(StaticVectorTests, testConstructsAndDestroysItems)
+{
+    // Items with non-trivial constructors and destructors are created on push and destroyed on pop
+    zct::StaticVector<std::string, 3> vector;
+    vector.push_back("first");
+    vector.emplace_back(5, 'x');
+    zassert_true(vector[0] == "first");
+    zassert_true(vector[1] == "xxxxx");
+
+    zct::StaticVector<std::string, 3> copy = vector;
+    vector.clear();
+    zassert_equal(copy.size(), 2);
+    zassert_true(copy[1] == "xxxxx");
+}
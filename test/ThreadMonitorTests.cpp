@@ -0,0 +1,99 @@
+#include <cstring>
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/ThreadMonitor.hpp"
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(ThreadMonitorTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(ThreadMonitorTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    struct BusyEvent {};
+    using Generic = std::variant<ExitEvent, BusyEvent>;
+} // namespace MyEvents
+
+class MonitoredClass {
+public:
+    MonitoredClass() :
+        m_eventThread(
+            "Monitored",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        )
+    {
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::BusyEvent>(event)) {
+                k_busy_wait(10000);
+            } else if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+    }
+
+    ~MonitoredClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+bool isRegistered(const char* name) {
+    bool found = false;
+    zct::ThreadMonitor::forEach([&found, name](zct::ThreadMonitor& monitor) {
+        if (strcmp(monitor.getName(), name) == 0) {
+            found = true;
+        }
+    });
+    return found;
+}
+
+ZTEST(ThreadMonitorTests, testEventThreadIsRegistered)
+{
+    {
+        MonitoredClass monitored;
+        zassert_true(isRegistered("Monitored"), "Event thread should be in the registry.");
+
+        // No stats until the thread has been started
+        zct::ThreadMonitor::Stats stats;
+        zassert_equal(monitored.m_eventThread.threadMonitor().getStats(stats), -ESRCH);
+        monitored.m_eventThread.start();
+    }
+    zassert_false(isRegistered("Monitored"), "Event thread should have been removed from the registry when destroyed.");
+}
+
+ZTEST(ThreadMonitorTests, testStatsAreReported)
+{
+    MonitoredClass monitored;
+    monitored.m_eventThread.start();
+    zct::ThreadMonitor::Stats stats;
+    monitored.m_eventThread.threadMonitor().getStats(stats);
+
+    // Thread spends 10ms out of every 20ms busy
+    for (int i = 0; i < 5; i++) {
+        monitored.m_eventThread.sendEvent(MyEvents::BusyEvent());
+        k_sleep(K_MSEC(20));
+    }
+
+    zassert_equal(monitored.m_eventThread.threadMonitor().getStats(stats), 0);
+    zct::ThreadMonitor::logAll();
+    zassert_equal(stats.stackSize_bytes, 1024);
+    zassert_true(stats.stackHighWater_bytes > 0 && stats.stackHighWater_bytes <= 1024, "Stack high-water mark of %zu is out of range.", stats.stackHighWater_bytes);
+    zassert_true(stats.runtime_us >= 50000, "Thread should have run for at least 50ms. Ran for %llu us.", stats.runtime_us);
+    zassert_true(stats.cpuLoad_percent >= 40 && stats.cpuLoad_percent <= 60, "CPU load should be around 50%%. Got %u%%.", stats.cpuLoad_percent);
+}
+
+} // namespace
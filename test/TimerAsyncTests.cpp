@@ -0,0 +1,116 @@
+#include <variant>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/EventThread.hpp"
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+#include "ZephyrCppToolkit/Events/TimerManager.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(TimerAsyncTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(TimerAsyncTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace MyEvents {
+    struct ExitEvent {};
+    using Generic = std::variant<ExitEvent>;
+} // namespace MyEvents
+
+class AsyncTimerTestClass {
+public:
+    AsyncTimerTestClass() :
+        m_eventThread(
+            "AsyncTimerTest",
+            m_threadStack,
+            THREAD_STACK_SIZE,
+            7,
+            EVENT_QUEUE_NUM_ITEMS
+        ),
+        m_longTimer("LongTimer", []() {}, m_eventThread.timerManager()),
+        m_shortTimer("ShortTimer", [this]() {
+            m_shortTimerExpiry_ticks = k_uptime_ticks();
+            atomic_inc(&m_shortTimerCount);
+        }, m_eventThread.timerManager())
+    {
+        m_eventThread.onExternalEvent([this](const MyEvents::Generic& event) {
+            if (std::holds_alternative<MyEvents::ExitEvent>(event)) {
+                m_eventThread.exitEventLoop();
+            }
+        });
+        // Makes the event loop block on a long timeout
+        m_longTimer.start(10000, -1);
+        m_eventThread.start();
+    }
+
+    ~AsyncTimerTestClass() {
+        m_eventThread.sendEvent(MyEvents::ExitEvent());
+    }
+
+    zct::EventThread<MyEvents::Generic> m_eventThread;
+    zct::Timer m_longTimer;
+    zct::Timer m_shortTimer;
+    atomic_t m_shortTimerCount = ATOMIC_INIT(0);
+    int64_t m_shortTimerExpiry_ticks = 0;
+
+private:
+    static constexpr size_t EVENT_QUEUE_NUM_ITEMS = 10;
+    static constexpr size_t THREAD_STACK_SIZE = 1024;
+    K_KERNEL_STACK_MEMBER(m_threadStack, THREAD_STACK_SIZE);
+};
+
+ZTEST(TimerAsyncTests, testCommandsAreAppliedByOwner)
+{
+    zct::TimerManager timerManager(2);
+    zct::Timer timer("Timer", []() {}, timerManager);
+    int numWakes = 0;
+    timerManager.setWakeCallback([&numWakes]() { numWakes++; });
+
+    timer.startAsync(100, -1);
+    // Nothing changes until the owner looks at its timers
+    zassert_false(timer.isRunning());
+    zassert_true(timerManager.hasPendingCommands());
+    zassert_equal(numWakes, 1);
+
+    // Only the first pending command wakes the owner, and the latest command wins
+    timer.stopAsync();
+    timer.startAsync(200, -1);
+    zassert_equal(numWakes, 1);
+
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer);
+    zassert_false(timerManager.hasPendingCommands());
+    zassert_true(timer.isRunning());
+
+    timer.stopAsync();
+    zassert_equal(numWakes, 2);
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "Timer should have been stopped.");
+}
+
+ZTEST(TimerAsyncTests, testShortTimerFiresWhileLoopIsBlocked)
+{
+    AsyncTimerTestClass testObj;
+    // Let the event loop block on the long timer
+    k_sleep(K_MSEC(10));
+
+    int64_t start_ticks = k_uptime_ticks();
+    testObj.m_shortTimer.startAsync(20, -1);
+    k_sleep(K_MSEC(50));
+
+    zassert_equal(atomic_get(&testObj.m_shortTimerCount), 1, "Short timer should have expired once.");
+    int64_t delay_ms = k_ticks_to_ms_floor64(testObj.m_shortTimerExpiry_ticks - start_ticks);
+    zassert_true(delay_ms >= 20 && delay_ms <= 25, "Short timer expired after %lld ms, expected 20 ms.", delay_ms);
+}
+
+ZTEST(TimerAsyncTests, testStopAsyncStopsRunningTimer)
+{
+    AsyncTimerTestClass testObj;
+    testObj.m_shortTimer.startAsync(20, -1);
+    k_sleep(K_MSEC(5));
+    testObj.m_shortTimer.stopAsync();
+    k_sleep(K_MSEC(50));
+
+    zassert_equal(atomic_get(&testObj.m_shortTimerCount), 0, "Short timer should have been stopped before it expired.");
+}
+
+} // namespace
@@ -0,0 +1,167 @@
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+#include "ZephyrCppToolkit/Events/TimerGroup.hpp"
+#include "ZephyrCppToolkit/Events/TimerManager.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(TimerManagerTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(TimerManagerTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(TimerManagerTests, testNextExpiringTimerTracksChanges)
+{
+    zct::TimerManager timerManager(3);
+    zct::Timer timer1("Timer1", []() {}, timerManager);
+    zct::Timer timer2("Timer2", []() {}, timerManager);
+    zct::Timer timer3("Timer3", []() {}, timerManager);
+
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "No timers are running.");
+
+    timer2.start(200, -1);
+    timer3.start(300, -1);
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer2);
+
+    // Starting a timer which expires earlier should make it the next expiring timer
+    timer1.start(100, -1);
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+
+    // Stopping a timer which is not the next to expire should make no difference
+    timer3.stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+
+    // Stopping the next expiring timer should fall back to the next earliest one
+    timer1.stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer2);
+
+    // Restarting the next expiring timer with a later expiry should let another timer become the earliest
+    timer3.start(50, -1);
+    timer3.start(500, -1);
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer2);
+
+    timer2.stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer3);
+    timer3.stop();
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "No timers are running.");
+}
+
+ZTEST(TimerManagerTests, testEarliestOfRunningAndStoppedTimers)
+{
+    zct::TimerManager timerManager(6);
+    zct::Timer timers[] = {
+        { "Timer0", []() {}, timerManager },
+        { "Timer1", []() {}, timerManager },
+        { "Timer2", []() {}, timerManager },
+        { "Timer3", []() {}, timerManager },
+        { "Timer4", []() {}, timerManager },
+        { "Timer5", []() {}, timerManager },
+    };
+
+    // Stopped timers are skipped even if they were due earlier than every running timer
+    timers[1].start(100, -1);
+    timers[3].start(50, -1);
+    timers[1].stop();
+    timers[3].stop();
+    timers[0].start(500, -1);
+    timers[2].start(300, -1);
+    timers[4].start(400, -1);
+    timers[5].start(300, -1);
+
+    // Timers due on the same tick are returned in slot order
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timers[2]);
+    timers[2].stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timers[5]);
+    timers[5].stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timers[4]);
+    timers[4].stop();
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timers[0]);
+    timers[0].stop();
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "No timers are running.");
+}
+
+ZTEST(TimerManagerTests, testSlotReuseAfterUnregister)
+{
+    zct::TimerManager timerManager(2);
+    zct::Timer timer1("Timer1", []() {}, timerManager);
+    {
+        zct::Timer timer2("Timer2", []() {}, timerManager);
+        timer2.start(100, -1);
+        zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer2);
+    }
+    // Timer2 unregistered itself when it was destroyed
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "No timers are running.");
+
+    // So its slot can be used by another timer
+    zct::Timer timer3("Timer3", []() {}, timerManager);
+    timer1.start(200, -1);
+    timer3.start(300, -1);
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+
+    // Unregistering timer1 moves timer3 into its slot
+    timerManager.unregisterTimer(timer1);
+    zassert_false(timer1.getIsRegistered());
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer3);
+    timer3.stop();
+    zassert_is_null(timerManager.getNextExpiringTimer().m_timer, "No registered timers are running.");
+
+    // Timer1 keeps its expiry time while unregistered, and expires again once re-registered
+    timerManager.registerTimer(timer1);
+    zassert_true(timer1.getIsRegistered());
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+}
+
+ZTEST(TimerManagerTests, testTimerGroupBulkOperations)
+{
+    zct::TimerManager timerManager(3);
+    zct::Timer timer1("Timer1", []() {}, timerManager);
+    zct::Timer timer2("Timer2", []() {}, timerManager);
+    zct::Timer timer3("Timer3", []() {}, timerManager);
+    zct::TimerGroup group(2);
+    group.add(timer1);
+    group.add(timer2);
+    zassert_equal(group.getNumTimers(), 2);
+
+    timer3.start(200, -1);
+    group.startAll(100, 50);
+    zassert_true(timer1.isRunning() && timer2.isRunning());
+    // Timers started together have exactly the same expiry time
+    zassert_equal(timer1.getNextExpiryTimeTicks(), timer2.getNextExpiryTimeTicks());
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+
+    // Shifting the group past timer3 should make timer3 the next to expire
+    int64_t expiryBeforeShift_ticks = timer1.getNextExpiryTimeTicks();
+    group.shiftAll(150);
+    zassert_equal(timer1.getNextExpiryTimeTicks(), expiryBeforeShift_ticks + (int64_t)k_ms_to_ticks_ceil64(150));
+    zassert_equal(timer1.getNextExpiryTimeTicks(), timer2.getNextExpiryTimeTicks());
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer3);
+
+    // And shifting it back should make the group the next to expire again
+    group.shiftAll(-150);
+    zassert_equal(timer1.getNextExpiryTimeTicks(), expiryBeforeShift_ticks);
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer1);
+
+    group.stopAll();
+    zassert_false(timer1.isRunning() || timer2.isRunning());
+    zassert_true(timer3.isRunning(), "Timers outside the group should not be affected.");
+    zassert_equal(timerManager.getNextExpiringTimer().m_timer, &timer3);
+}
+
+ZTEST(TimerManagerTests, testStaticTimerGroup)
+{
+    zct::TimerManager timerManager(2);
+    zct::Timer timer1("Timer1", []() {}, timerManager);
+    zct::Timer timer2("Timer2", []() {}, timerManager);
+    zct::StaticTimerGroup<2> group;
+    group.add(timer1);
+    group.add(timer2);
+    zassert_equal(group.getNumTimers(), 2);
+
+    group.startAll(100, -1);
+    zassert_true(timer1.isRunning() && timer2.isRunning());
+    group.stopAll();
+    zassert_false(timer1.isRunning() || timer2.isRunning());
+}
+
+} // namespace
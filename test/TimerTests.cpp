@@ -0,0 +1,120 @@
+#include <chrono>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Events/Timer.hpp"
+#include "ZephyrCppToolkit/Events/TimerManager.hpp"
+
+namespace {
+
+LOG_MODULE_REGISTER(TimerTests, LOG_LEVEL_DBG);
+
+ZTEST_SUITE(TimerTests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(TimerTests, testTickAndTimeoutStart)
+{
+    zct::TimerManager timerManager(1);
+    zct::Timer timer("Timer", []() {}, timerManager);
+
+    int64_t before_ticks = k_uptime_ticks();
+    timer.startTicks(5, 3);
+    int64_t after_ticks = k_uptime_ticks();
+    int64_t firstExpiry_ticks = timer.getNextExpiryTimeTicks();
+    zassert_true(firstExpiry_ticks >= before_ticks + 5 && firstExpiry_ticks <= after_ticks + 5);
+    timer.updateAfterExpiry();
+    zassert_equal(timer.getNextExpiryTimeTicks(), firstExpiry_ticks + 3);
+
+    // K_FOREVER period makes a one-shot timer
+    timer.start(K_TICKS(2), K_FOREVER);
+    zassert_true(timer.isRunning());
+    timer.updateAfterExpiry();
+    zassert_false(timer.isRunning());
+}
+
+ZTEST(TimerTests, testFractionalPeriodDoesNotDrift)
+{
+    zct::TimerManager timerManager(1);
+    zct::Timer timer("Timer", []() {}, timerManager);
+
+    // Pick a period which is not a whole number of ticks at any common tick rate
+    constexpr int64_t period_us = 333;
+    timer.start(std::chrono::microseconds(0), std::chrono::microseconds(period_us));
+    int64_t firstExpiry_ticks = timer.getNextExpiryTimeTicks();
+
+    for (int64_t i = 1; i <= 1000; i++) {
+        timer.updateAfterExpiry();
+        // Every expiry should be the exact expiry time rounded up to the next tick, with no accumulated error
+        zassert_equal(timer.getNextExpiryTimeTicks(), firstExpiry_ticks + (int64_t)k_us_to_ticks_ceil64(i * period_us), "Expiry %lld drifted.", i);
+    }
+}
+
+ZTEST(TimerTests, testStartAtAbsoluteTime)
+{
+    zct::TimerManager timerManager(1);
+    zct::Timer timer("Timer", []() {}, timerManager);
+
+    int64_t expiryTime_ticks = k_uptime_ticks() + 100;
+    timer.startAtTicks(expiryTime_ticks, 10);
+    zassert_equal(timer.getNextExpiryTimeTicks(), expiryTime_ticks);
+    timer.updateAfterExpiry();
+    zassert_equal(timer.getNextExpiryTimeTicks(), expiryTime_ticks + 10);
+}
+
+ZTEST(TimerTests, testAlignedTimersExpireTogether)
+{
+    zct::TimerManager timerManager(2);
+    zct::Timer timer1("Timer1", []() {}, timerManager);
+    zct::Timer timer2("Timer2", []() {}, timerManager);
+
+    constexpr int64_t period_ms = 100;
+    constexpr int64_t phase_ms = 10;
+    timer1.startAligned(period_ms, phase_ms);
+    int64_t firstExpiry_ticks = timer1.getNextExpiryTimeTicks();
+    zassert_true(firstExpiry_ticks >= k_uptime_ticks());
+    zassert_equal(k_ticks_to_ms_floor64(firstExpiry_ticks) % period_ms, phase_ms, "Expiry is not aligned.");
+
+    // Starting another timer later with the same period should give exactly the same expiry times
+    k_sleep(K_MSEC(35));
+    timer2.startAligned(period_ms, phase_ms);
+    while (timer1.getNextExpiryTimeTicks() < timer2.getNextExpiryTimeTicks()) {
+        timer1.updateAfterExpiry();
+    }
+    for (int i = 0; i < 10; i++) {
+        zassert_equal(timer1.getNextExpiryTimeTicks(), timer2.getNextExpiryTimeTicks());
+        timer1.updateAfterExpiry();
+        timer2.updateAfterExpiry();
+    }
+}
+
+ZTEST(TimerTests, testLatenessStats)
+{
+    zct::TimerManager timerManager(1);
+    zct::Timer timer("Timer", []() {}, timerManager);
+    timer.setStatsEnabled(true);
+
+    timer.startTicks(0, 100);
+    k_sleep(K_TICKS(250));
+    // Handle the first expiry 250 or more ticks late, by which time the next two expiries are also due
+    timer.updateAfterExpiry();
+    timer.updateAfterExpiry();
+    timer.updateAfterExpiry();
+
+    const zct::Timer::Stats& stats = timer.getStats();
+    zassert_equal(stats.numExpiries, 3);
+    zassert_equal(stats.numCatchUpExpiries, 2, "Expected 2 catch-up expiries. Got %u.", stats.numCatchUpExpiries);
+    zassert_true(stats.minLateness_ticks >= 50);
+    zassert_true(stats.maxLateness_ticks >= 250);
+    zassert_true(stats.getMeanLateness_ticks() >= stats.minLateness_ticks && stats.getMeanLateness_ticks() <= stats.maxLateness_ticks);
+    uint32_t numInHistogram = 0;
+    for (uint32_t i = 0; i < zct::Timer::Stats::NUM_HISTOGRAM_BUCKETS; i++) {
+        numInHistogram += stats.latenessHistogram[i];
+    }
+    zassert_equal(numInHistogram, 3);
+    timerManager.logStats("Timer");
+
+    timer.resetStats();
+    zassert_equal(timer.getStats().numExpiries, 0);
+}
+
+} // namespace
@@ -0,0 +1,61 @@
+#include <zephyr/ztest.h>
+
+#include "ZephyrCppToolkit/Core/TripleBuffer.hpp"
+
+ZTEST_SUITE(TripleBufferTests, NULL, NULL, NULL, NULL, NULL);
+
+namespace {
+
+struct Frame {
+    uint32_t id;
+    uint32_t data[32];
+};
+
+} // namespace
+
+ZTEST(TripleBufferTests, testLatestFrameWins)
+{
+    zct::TripleBuffer<Frame> tripleBuffer;
+
+    // Nothing published yet
+    zassert_false(tripleBuffer.update());
+
+    tripleBuffer.getWriteBuffer().id = 1;
+    tripleBuffer.publish();
+    zassert_true(tripleBuffer.update());
+    zassert_equal(tripleBuffer.getReadBuffer().id, 1);
+
+    // No new frame, the read buffer stays the same
+    zassert_false(tripleBuffer.update());
+    zassert_equal(tripleBuffer.getReadBuffer().id, 1);
+
+    // Publish two frames before the consumer looks, it should only see the latest
+    tripleBuffer.getWriteBuffer().id = 2;
+    tripleBuffer.publish();
+    tripleBuffer.getWriteBuffer().id = 3;
+    tripleBuffer.publish();
+    zassert_true(tripleBuffer.update());
+    zassert_equal(tripleBuffer.getReadBuffer().id, 3);
+}
+
+ZTEST(TripleBufferTests, testProducerNeverOverwritesReadBuffer)
+{
+    zct::TripleBuffer<Frame> tripleBuffer;
+
+    tripleBuffer.getWriteBuffer().id = 1;
+    tripleBuffer.publish();
+    zassert_true(tripleBuffer.update());
+    const Frame& readFrame = tripleBuffer.getReadBuffer();
+
+    // However much the producer publishes, the frame being read is not touched
+    for (uint32_t id = 2; id < 10; id++) {
+        Frame& writeFrame = tripleBuffer.getWriteBuffer();
+        zassert_not_equal(&writeFrame, &readFrame);
+        writeFrame.id = id;
+        tripleBuffer.publish();
+    }
+    zassert_equal(readFrame.id, 1);
+
+    zassert_true(tripleBuffer.update());
+    zassert_equal(tripleBuffer.getReadBuffer().id, 9);
+}
@@ -212,6 +212,22 @@ ZTEST(WatchdogTests, mockWatchdogMultipleChannels)
     zassert_equal(info3->timeoutMs, 500, "Channel3 timeout should be 500ms");
 }
 
+ZTEST(WatchdogTests, mockWatchdogInstallFailsWhenFull)
+{
+    zct::WatchdogMock wdt("TestWdt");
+
+    for (size_t i = 0; i < zct::WatchdogMock::MAX_NUM_CHANNELS; i++) {
+        zassert_equal(wdt.installTimeout(1000), static_cast<int>(i), "Channel IDs should be assigned in order");
+    }
+
+    zassert_equal(wdt.installTimeout(1000), -ENOMEM, "Install should fail once all channels are used");
+    zassert_equal(wdt.mockGetChannelCount(), zct::WatchdogMock::MAX_NUM_CHANNELS, "Failed install should not add a channel");
+
+    // Reset frees the channels again
+    wdt.mockReset();
+    zassert_equal(wdt.installTimeout(1000), 0, "Install should succeed after reset");
+}
+
 // Uncomment this test if you have real watchdog hardware available and properly configured
 /*
 ZTEST(WatchdogTests, realWatchdogBasicOperation)